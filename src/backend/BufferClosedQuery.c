@@ -0,0 +1,25 @@
+
+#include "BufferClosedQuery.h"
+#include "SemanticTokensQuery.h"
+
+#include "DRVR/overlay.h"
+#include "UTIL/filename.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+void handle_buffer_closed_query(query_t *query, json_builder_t *builder){
+    if(query->filename == NULL){
+        json_build_string(builder, "Buffer closed query is missing field 'filename'");
+        return;
+    }
+
+    // Files that don't exist on disk never have unsaved contents kept for them
+    if(file_exists(query->filename)){
+        strong_cstr_t absolute = filename_absolute(query->filename);
+        if(absolute) overlay_remove(absolute);
+        free(absolute);
+    }
+
+    semantic_tokens_forget(query->filename);
+    json_build_null(builder);
+}
@@ -0,0 +1,146 @@
+
+#include <stdlib.h>
+
+#include "CallHierarchyQuery.h"
+
+#include "DRVR/call_graph.h"
+#include "UTIL/filename.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+static void build_call_hierarchy_range(json_builder_t *builder, call_graph_position_t begin, call_graph_position_t end){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "start");
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, begin.line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, begin.character);
+    json_build_object_end(builder);
+    json_build_next(builder);
+    json_build_object_key(builder, "end");
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, end.line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, end.character);
+    json_build_object_end(builder);
+    json_build_object_end(builder);
+}
+
+static void build_call_hierarchy_item(json_builder_t *builder, call_graph_item_t *item){
+    // Items are given in the form that the frontend hands back to the client as-is
+    strong_cstr_t uri = mallocandsprintf("file://%s", item->absolute);
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "name");
+    json_build_string(builder, item->name);
+    json_build_next(builder);
+    json_build_object_key(builder, "kind");
+    json_build_integer(builder, 12); // Function
+    json_build_next(builder);
+    json_build_object_key(builder, "uri");
+    json_build_string(builder, uri);
+    json_build_next(builder);
+    json_build_object_key(builder, "range");
+    build_call_hierarchy_range(builder, item->begin, item->end);
+    json_build_next(builder);
+    json_build_object_key(builder, "selectionRange");
+    build_call_hierarchy_range(builder, item->name_begin, item->name_end);
+    json_build_object_end(builder);
+
+    free(uri);
+}
+
+static bool call_hierarchy_same_item(call_graph_item_t *a, call_graph_item_t *b){
+    // Items borrow their filenames from the graph, so they can be compared by address
+    return a->absolute == b->absolute && a->begin.line == b->begin.line && a->begin.character == b->begin.character;
+}
+
+static void build_calls_by_item(json_builder_t *builder, call_graph_call_list_t *calls, weak_cstr_t item_key){
+    // Calls are grouped by the function on the other end, so each group becomes one entry
+    json_build_array_start(builder);
+
+    for(length_t group = 0; group != calls->length;){
+        call_graph_item_t *item = &calls->calls[group].item;
+
+        length_t group_end = group + 1;
+        while(group_end != calls->length && call_hierarchy_same_item(item, &calls->calls[group_end].item)) group_end++;
+
+        if(group != 0) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, item_key);
+        build_call_hierarchy_item(builder, item);
+        json_build_next(builder);
+        json_build_object_key(builder, "fromRanges");
+        json_build_array_start(builder);
+
+        for(length_t i = group; i != group_end; i++){
+            if(i != group) json_build_next(builder);
+            build_call_hierarchy_range(builder, calls->calls[i].begin, calls->calls[i].end);
+        }
+
+        json_build_array_end(builder);
+        json_build_object_end(builder);
+        group = group_end;
+    }
+
+    json_build_array_end(builder);
+}
+
+void handle_call_hierarchy_query(query_t *query, json_builder_t *builder){
+    if(query->name == NULL){
+        json_build_string(builder, "Call hierarchy query is missing field 'name'");
+        return;
+    }
+
+    call_graph_item_list_t items = call_graph_find(query->name);
+
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != items.length; i++){
+        if(i != 0) json_build_next(builder);
+        build_call_hierarchy_item(builder, &items.items[i]);
+    }
+
+    json_build_array_end(builder);
+    free(items.items);
+}
+
+void handle_incoming_calls_query(query_t *query, json_builder_t *builder){
+    if(query->name == NULL){
+        json_build_string(builder, "Incoming calls query is missing field 'name'");
+        return;
+    }
+
+    call_graph_call_list_t calls = call_graph_incoming(query->name);
+    build_calls_by_item(builder, &calls, "from");
+    free(calls.calls);
+}
+
+void handle_outgoing_calls_query(query_t *query, json_builder_t *builder){
+    if(query->filename == NULL){
+        json_build_string(builder, "Outgoing calls query is missing field 'filename'");
+        return;
+    }
+
+    if(!query->has_range){
+        json_build_string(builder, "Outgoing calls query is missing field 'range'");
+        return;
+    }
+
+    // The function is the one that begins at the start of the range
+    call_graph_position_t begin = {
+        .line = query->range_start_line,
+        .character = query->range_start_character,
+    };
+
+    maybe_null_strong_cstr_t absolute = filename_absolute(query->filename);
+    call_graph_call_list_t calls = absolute ? call_graph_outgoing(absolute, begin) : (call_graph_call_list_t){0};
+    free(absolute);
+
+    build_calls_by_item(builder, &calls, "to");
+    free(calls.calls);
+}
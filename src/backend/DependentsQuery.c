@@ -0,0 +1,32 @@
+
+#include "DependentsQuery.h"
+
+#include "DRVR/dependency_graph.h"
+#include "UTIL/filename.h"
+#include "UTIL/string_list.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+void handle_dependents_query(query_t *query, json_builder_t *builder){
+    // Files that import the given files are the only ones that have to be
+    // analyzed again, and are listed in the order to analyze them in
+    // NOTE: The given files may have just been created or deleted
+    strong_cstr_list_t absolutes = {0};
+
+    for(length_t i = 0; i != query->files.length; i++){
+        strong_cstr_t absolute = filename_absolute_maybe_missing(query->files.items[i]);
+        if(absolute) strong_cstr_list_append(&absolutes, absolute);
+    }
+
+    strong_cstr_list_t dependents = dependency_graph_dependents(&absolutes);
+    strong_cstr_list_free(&absolutes);
+
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != dependents.length; i++){
+        if(i != 0) json_build_next(builder);
+        json_build_string(builder, dependents.items[i]);
+    }
+
+    json_build_array_end(builder);
+    strong_cstr_list_free(&dependents);
+}
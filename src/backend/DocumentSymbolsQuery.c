@@ -0,0 +1,522 @@
+
+#include <stdlib.h>
+
+#include "DocumentSymbolsQuery.h"
+
+#include "compilation.h"
+#include "json_builder_ex.h"
+#include "line_index.h"
+#include "token_range.h"
+
+#include "AST/ast.h"
+#include "AST/ast_type.h"
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/util.h"
+#include "UTIL/string.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Longest member name that is looked for in the code
+#define DOCUMENT_SYMBOLS_MAX_WORD 256
+
+// LSP SymbolKind
+#define SYMBOL_KIND_CLASS          5
+#define SYMBOL_KIND_METHOD         6
+#define SYMBOL_KIND_FIELD          8
+#define SYMBOL_KIND_CONSTRUCTOR    9
+#define SYMBOL_KIND_ENUM           10
+#define SYMBOL_KIND_INTERFACE      11
+#define SYMBOL_KIND_FUNCTION       12
+#define SYMBOL_KIND_VARIABLE       13
+#define SYMBOL_KIND_CONSTANT       14
+#define SYMBOL_KIND_ENUM_MEMBER    22
+#define SYMBOL_KIND_STRUCT         23
+
+// ---------------- document_symbol_kind_t ----------------
+// What a document symbol refers to
+typedef enum {
+    DOCUMENT_SYMBOL_FUNC,
+    DOCUMENT_SYMBOL_METHOD,
+    DOCUMENT_SYMBOL_COMPOSITE,
+    DOCUMENT_SYMBOL_ENUM,
+    DOCUMENT_SYMBOL_ALIAS,
+    DOCUMENT_SYMBOL_GLOBAL,
+    DOCUMENT_SYMBOL_NAMED_EXPRESSION,
+} document_symbol_kind_t;
+
+// ---------------- document_symbol_t ----------------
+// A symbol of a document, with the tokens that it spans
+typedef struct {
+    document_symbol_kind_t kind;
+    void *item;
+    ast_composite_t *parent; // Composite that a method is declared within
+    length_t first;          // Index of the first token
+    length_t last;           // Index of the last token
+} document_symbol_t;
+
+// ---------------- document_symbols_t ----------------
+// List of document symbols, in the order that they are declared
+typedef struct {
+    document_symbol_t *symbols;
+    length_t length;
+    length_t capacity;
+} document_symbols_t;
+
+// ---------------- document_symbols_ctx_t ----------------
+// State for finding the symbols of a document
+typedef struct {
+    ast_t *ast;
+    object_t *object;
+    tokenlist_t *tokenlist;
+    line_index_t line_index;
+    document_symbols_t symbols;
+} document_symbols_ctx_t;
+
+static void document_symbols_add(document_symbols_ctx_t *ctx, document_symbol_kind_t kind, void *item, ast_composite_t *parent, length_t first, length_t last){
+    document_symbols_t *symbols = &ctx->symbols;
+
+    expand((void**) &symbols->symbols, sizeof(document_symbol_t), symbols->length, &symbols->capacity, 1, 64);
+
+    symbols->symbols[symbols->length++] = (document_symbol_t){
+        .kind = kind,
+        .item = item,
+        .parent = parent,
+        .first = first,
+        .last = last,
+    };
+}
+
+static int document_symbols_compare(const void *a, const void *b){
+    length_t a_first = ((const document_symbol_t*) a)->first;
+    length_t b_first = ((const document_symbol_t*) b)->first;
+    return a_first < b_first ? -1 : a_first > b_first;
+}
+
+static bool document_symbols_token_at(document_symbols_ctx_t *ctx, source_t source, length_t *out_token){
+    // Only symbols declared in the document itself are given,
+    // which excludes the prelude since it has no sources
+    if(source.object_index != ctx->object->index || source.stride == 0) return false;
+
+    length_t token = token_range_first_at(ctx->tokenlist, source.index);
+    if(token == ctx->tokenlist->length || ctx->tokenlist->sources[token].index != source.index) return false;
+
+    *out_token = token;
+    return true;
+}
+
+static length_t document_symbols_extent(document_symbols_ctx_t *ctx, length_t first){
+    // Finds the last token of a declaration, which ends at the first newline outside of any
+    // parentheses, brackets, or braces, unless it's followed by a domain or body
+    token_t *tokens = ctx->tokenlist->tokens;
+    length_t length = ctx->tokenlist->length;
+    length_t depth = 0;
+    length_t last = first;
+
+    for(length_t i = first; i != length; i++){
+        switch(tokens[i].id){
+        case TOKEN_OPEN:
+        case TOKEN_BRACKET_OPEN:
+        case TOKEN_BEGIN:
+            depth++;
+            break;
+        case TOKEN_CLOSE:
+        case TOKEN_BRACKET_CLOSE:
+        case TOKEN_END:
+            if(depth != 0) depth--;
+            break;
+        case TOKEN_NEWLINE:
+            if(depth == 0){
+                length_t next = i;
+                while(next != length && tokens[next].id == TOKEN_NEWLINE) next++;
+                if(next == length || tokens[next].id != TOKEN_BEGIN) return last;
+                i = next - 1;
+            }
+            continue;
+        }
+
+        last = i;
+    }
+
+    return last;
+}
+
+static length_t document_symbols_name(document_symbols_ctx_t *ctx, length_t first){
+    // Declarations begin with keywords, so their names are the first words that follow
+    token_t *tokens = ctx->tokenlist->tokens;
+
+    for(length_t i = first; i != ctx->tokenlist->length; i++){
+        switch(tokens[i].id){
+        case TOKEN_WORD:
+            return i;
+        case TOKEN_OPEN:
+        case TOKEN_BEGIN:
+        case TOKEN_NEWLINE:
+        case TOKEN_ASSIGN:
+            return first;
+        }
+    }
+
+    return first;
+}
+
+static length_t document_symbols_find_member(document_symbols_ctx_t *ctx, length_t first, length_t last, weak_cstr_t name){
+    // Finds where a field or enum member is named within the first parentheses of a declaration
+    // Returns the length of the token list if it can't be found
+    token_t *tokens = ctx->tokenlist->tokens;
+    length_t depth = 0;
+
+    for(length_t i = first; i <= last; i++){
+        switch(tokens[i].id){
+        case TOKEN_OPEN:
+        case TOKEN_BRACKET_OPEN:
+        case TOKEN_BEGIN:
+            depth++;
+            break;
+        case TOKEN_CLOSE:
+        case TOKEN_BRACKET_CLOSE:
+        case TOKEN_END:
+            if(--depth == 0) return ctx->tokenlist->length;
+            break;
+        case TOKEN_WORD:
+            if(depth == 1){
+                char word[DOCUMENT_SYMBOLS_MAX_WORD];
+                if(token_range_word(ctx->tokenlist, ctx->object->buffer, i, word, DOCUMENT_SYMBOLS_MAX_WORD) && streq(word, name)) return i;
+            }
+            break;
+        }
+    }
+
+    return ctx->tokenlist->length;
+}
+
+static length_t document_symbols_func_extent(document_symbols_ctx_t *ctx, ast_func_t *func, length_t first){
+    // Function bodies end where the parser says they do
+    if(!(func->traits & AST_FUNC_FOREIGN) && func->end_source.index > func->source.index){
+        length_t end = token_range_first_at(ctx->tokenlist, func->end_source.index);
+        if(end != ctx->tokenlist->length) return end;
+    }
+
+    return document_symbols_extent(ctx, first);
+}
+
+static void document_symbols_nest(document_symbols_ctx_t *ctx){
+    // Methods declared within the domain of a composite are given as its children
+    // NOTE: Symbols are sorted by where they begin, so the innermost composite
+    //       that encloses a function is the one on top of the stack
+    document_symbols_t *symbols = &ctx->symbols;
+    document_symbol_t **stack = malloc(sizeof(document_symbol_t*) * (symbols->length ? symbols->length : 1));
+    length_t stack_length = 0;
+
+    for(length_t i = 0; i != symbols->length; i++){
+        document_symbol_t *symbol = &symbols->symbols[i];
+
+        while(stack_length != 0 && stack[stack_length - 1]->last <= symbol->first) stack_length--;
+
+        if(symbol->kind == DOCUMENT_SYMBOL_FUNC && stack_length != 0){
+            symbol->kind = DOCUMENT_SYMBOL_METHOD;
+            symbol->parent = stack[stack_length - 1]->item;
+        }
+
+        if(symbol->kind == DOCUMENT_SYMBOL_COMPOSITE) stack[stack_length++] = symbol;
+    }
+
+    free(stack);
+}
+
+static void document_symbols_collect(document_symbols_ctx_t *ctx){
+    ast_t *ast = ctx->ast;
+    length_t first;
+
+    for(length_t i = 0; i != ast->composites_length; i++){
+        ast_composite_t *composite = &ast->composites[i];
+        if(!document_symbols_token_at(ctx, composite->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_COMPOSITE, composite, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    for(length_t i = 0; i != ast->poly_composites_length; i++){
+        ast_composite_t *composite = (ast_composite_t*) &ast->poly_composites[i];
+        if(!document_symbols_token_at(ctx, composite->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_COMPOSITE, composite, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+
+        if(func->traits & (AST_FUNC_GENERATED | AST_FUNC_AUTOGEN)) continue;
+        if(!document_symbols_token_at(ctx, func->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_FUNC, func, NULL, first, document_symbols_func_extent(ctx, func, first));
+    }
+
+    for(length_t i = 0; i != ast->enums_length; i++){
+        ast_enum_t *enum_definition = &ast->enums[i];
+        if(!document_symbols_token_at(ctx, enum_definition->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_ENUM, enum_definition, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    for(length_t i = 0; i != ast->aliases_length; i++){
+        ast_alias_t *alias = &ast->aliases[i];
+        if(!document_symbols_token_at(ctx, alias->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_ALIAS, alias, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    for(length_t i = 0; i != ast->globals_length; i++){
+        ast_global_t *global = &ast->globals[i];
+        if(global->traits & AST_GLOBAL_SPECIAL) continue;
+        if(!document_symbols_token_at(ctx, global->source, &first)) continue;
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_GLOBAL, global, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    for(length_t i = 0; i != ast->named_expressions.length; i++){
+        ast_named_expression_t *named_expression = &ast->named_expressions.expressions[i];
+        if(!document_symbols_token_at(ctx, named_expression->source, &first)) continue;
+
+        // Enums can create named expressions for their members, which are already given
+        if(ctx->tokenlist->tokens[first].id == TOKEN_ENUM) continue;
+
+        document_symbols_add(ctx, DOCUMENT_SYMBOL_NAMED_EXPRESSION, named_expression, NULL, first, document_symbols_extent(ctx, first));
+    }
+
+    qsort(ctx->symbols.symbols, ctx->symbols.length, sizeof(document_symbol_t), document_symbols_compare);
+    document_symbols_nest(ctx);
+}
+
+static void document_symbols_build_position(json_builder_t *builder, document_symbols_ctx_t *ctx, length_t offset){
+    length_t line, character;
+    line_index_position(&ctx->line_index, offset, &line, &character);
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, character);
+    json_build_object_end(builder);
+}
+
+static void document_symbols_build_range(json_builder_t *builder, document_symbols_ctx_t *ctx, length_t first, length_t last){
+    source_t begin = ctx->tokenlist->sources[first];
+    source_t end = ctx->tokenlist->sources[last];
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "start");
+    document_symbols_build_position(builder, ctx, begin.index);
+    json_build_next(builder);
+    json_build_object_key(builder, "end");
+    document_symbols_build_position(builder, ctx, end.index + end.stride);
+    json_build_object_end(builder);
+}
+
+static void document_symbols_build_start(json_builder_t *builder, document_symbols_ctx_t *ctx, weak_cstr_t name, int kind, length_t first, length_t last, length_t selection){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "name");
+    json_build_string(builder, name);
+    json_build_next(builder);
+    json_build_object_key(builder, "kind");
+    json_build_integer(builder, kind);
+    json_build_next(builder);
+    json_build_object_key(builder, "range");
+    document_symbols_build_range(builder, ctx, first, last);
+    json_build_next(builder);
+    json_build_object_key(builder, "selectionRange");
+    document_symbols_build_range(builder, ctx, selection, selection);
+}
+
+static int document_symbols_alias_kind(document_symbols_ctx_t *ctx, ast_alias_t *alias){
+    // Aliases are given as the kind of type that they name
+    if(ast_type_is_func(&alias->type)) return SYMBOL_KIND_INTERFACE;
+
+    ast_composite_t *composite = ast_find_composite(ctx->ast, &alias->type);
+    return composite && composite->is_class ? SYMBOL_KIND_CLASS : SYMBOL_KIND_STRUCT;
+}
+
+static void document_symbols_build_detail(json_builder_t *builder, ast_type_t *type){
+    strong_cstr_t detail = ast_type_str(type);
+    json_build_next(builder);
+    json_build_object_key(builder, "detail");
+    json_build_string(builder, detail);
+    free(detail);
+}
+
+static void document_symbols_build_func(json_builder_t *builder, document_symbols_ctx_t *ctx, ast_func_t *func, length_t first, length_t last, bool is_method){
+    int kind = is_method ? SYMBOL_KIND_METHOD : SYMBOL_KIND_FUNCTION;
+    if(streq(func->name, "__constructor__")) kind = SYMBOL_KIND_CONSTRUCTOR;
+
+    document_symbols_build_start(builder, ctx, func->name, kind, first, last, document_symbols_name(ctx, first));
+
+    // Only the parameters and return type, since the name is already given
+    json_build_next(builder);
+    json_build_object_key(builder, "detail");
+    json_builder_append(builder, "\"");
+    json_build_func_parameters(builder, func->arg_names, func->arg_types, func->arg_type_traits, func->arg_defaults, func->arity, func->traits, func->variadic_arg_name);
+    json_builder_append(builder, " ");
+
+    strong_cstr_t return_type = ast_type_str(&func->return_type);
+    json_builder_append_escaped(builder, return_type);
+    free(return_type);
+
+    json_builder_append(builder, "\"");
+    json_build_object_end(builder);
+}
+
+static void document_symbols_build_composite(json_builder_t *builder, document_symbols_ctx_t *ctx, length_t symbol_index){
+    document_symbol_t *symbol = &ctx->symbols.symbols[symbol_index];
+    ast_composite_t *composite = symbol->item;
+    ast_field_map_t *field_map = &composite->layout.field_map;
+
+    int kind = composite->is_class ? SYMBOL_KIND_CLASS : SYMBOL_KIND_STRUCT;
+    document_symbols_build_start(builder, ctx, composite->name, kind, symbol->first, symbol->last, document_symbols_name(ctx, symbol->first));
+
+    json_build_next(builder);
+    json_build_object_key(builder, "children");
+    json_build_array_start(builder);
+
+    bool is_first = true;
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        weak_cstr_t name = field_map->arrows[i].name;
+        length_t token = document_symbols_find_member(ctx, symbol->first, symbol->last, name);
+        if(token == ctx->tokenlist->length) continue;
+
+        if(!is_first) json_build_next(builder);
+        is_first = false;
+
+        document_symbols_build_start(builder, ctx, name, SYMBOL_KIND_FIELD, token, token, token);
+        json_build_object_end(builder);
+    }
+
+    // Methods are declared within the composite, so they directly follow it
+    for(length_t i = symbol_index + 1; i != ctx->symbols.length; i++){
+        document_symbol_t *method = &ctx->symbols.symbols[i];
+        if(method->kind != DOCUMENT_SYMBOL_METHOD || method->parent != composite) break;
+
+        if(!is_first) json_build_next(builder);
+        is_first = false;
+
+        document_symbols_build_func(builder, ctx, method->item, method->first, method->last, true);
+    }
+
+    json_build_array_end(builder);
+    json_build_object_end(builder);
+}
+
+static void document_symbols_build_enum(json_builder_t *builder, document_symbols_ctx_t *ctx, document_symbol_t *symbol){
+    ast_enum_t *enum_definition = symbol->item;
+
+    document_symbols_build_start(builder, ctx, enum_definition->name, SYMBOL_KIND_ENUM, symbol->first, symbol->last, document_symbols_name(ctx, symbol->first));
+
+    json_build_next(builder);
+    json_build_object_key(builder, "children");
+    json_build_array_start(builder);
+
+    bool is_first = true;
+
+    for(length_t i = 0; i != enum_definition->length; i++){
+        weak_cstr_t name = enum_definition->kinds[i];
+        length_t token = document_symbols_find_member(ctx, symbol->first, symbol->last, name);
+        if(token == ctx->tokenlist->length) continue;
+
+        if(!is_first) json_build_next(builder);
+        is_first = false;
+
+        document_symbols_build_start(builder, ctx, name, SYMBOL_KIND_ENUM_MEMBER, token, token, token);
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+    json_build_object_end(builder);
+}
+
+static void document_symbols_build(json_builder_t *builder, document_symbols_ctx_t *ctx){
+    json_build_array_start(builder);
+
+    bool is_first = true;
+
+    for(length_t i = 0; i != ctx->symbols.length; i++){
+        document_symbol_t *symbol = &ctx->symbols.symbols[i];
+        length_t name = document_symbols_name(ctx, symbol->first);
+
+        if(symbol->kind == DOCUMENT_SYMBOL_METHOD) continue;
+
+        if(!is_first) json_build_next(builder);
+        is_first = false;
+
+        switch(symbol->kind){
+        case DOCUMENT_SYMBOL_FUNC:
+            document_symbols_build_func(builder, ctx, symbol->item, symbol->first, symbol->last, ast_func_is_method(symbol->item));
+            break;
+        case DOCUMENT_SYMBOL_METHOD:
+            // Already given as children of composites
+            break;
+        case DOCUMENT_SYMBOL_COMPOSITE:
+            document_symbols_build_composite(builder, ctx, i);
+            break;
+        case DOCUMENT_SYMBOL_ENUM:
+            document_symbols_build_enum(builder, ctx, symbol);
+            break;
+        case DOCUMENT_SYMBOL_ALIAS: {
+                ast_alias_t *alias = symbol->item;
+                document_symbols_build_start(builder, ctx, alias->name, document_symbols_alias_kind(ctx, alias), symbol->first, symbol->last, name);
+                document_symbols_build_detail(builder, &alias->type);
+                json_build_object_end(builder);
+            }
+            break;
+        case DOCUMENT_SYMBOL_GLOBAL: {
+                ast_global_t *global = symbol->item;
+                document_symbols_build_start(builder, ctx, global->name, SYMBOL_KIND_VARIABLE, symbol->first, symbol->last, name);
+                document_symbols_build_detail(builder, &global->type);
+                json_build_object_end(builder);
+            }
+            break;
+        case DOCUMENT_SYMBOL_NAMED_EXPRESSION: {
+                ast_named_expression_t *named_expression = symbol->item;
+                document_symbols_build_start(builder, ctx, named_expression->name, SYMBOL_KIND_CONSTANT, symbol->first, symbol->last, name);
+                json_build_object_end(builder);
+            }
+            break;
+        }
+    }
+
+    json_build_array_end(builder);
+}
+
+void handle_document_symbols_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Document symbols query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Document symbols query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Document symbols query is missing field 'code'");
+        return;
+    }
+
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex(&compilation, query);
+
+    if(lex_errorcode || compilation_parse(&compilation) || compilation.object == NULL){
+        compilation_finish(&compilation);
+        json_build_null(builder);
+        return;
+    }
+
+    object_t *object = compilation.object;
+
+    document_symbols_ctx_t ctx = {
+        .ast = &compilation.root->ast,
+        .object = object,
+        .tokenlist = &object->tokenlist,
+    };
+
+    line_index_init(&ctx.line_index, object->buffer, object->buffer_length);
+    document_symbols_collect(&ctx);
+    document_symbols_build(builder, &ctx);
+    line_index_free(&ctx.line_index);
+    free(ctx.symbols.symbols);
+
+    compilation_finish(&compilation);
+}
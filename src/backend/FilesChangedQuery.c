@@ -0,0 +1,17 @@
+
+#include "FilesChangedQuery.h"
+
+#include "UTIL/file_watcher.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+void handle_files_changed_query(query_t *query, json_builder_t *builder){
+    // Changes reported by the client are handled together with the ones
+    // noticed by the file watcher, right before the next compilation
+    // NOTE: Every change is treated as possibly creating or removing the file,
+    // since the client might combine several changes into one
+    for(length_t i = 0; i != query->files.length; i++){
+        file_watcher_notify(query->files.items[i], true);
+    }
+
+    json_build_null(builder);
+}
@@ -0,0 +1,400 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "FoldingRangesQuery.h"
+
+#include "compilation.h"
+#include "line_index.h"
+#include "token_range.h"
+
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/hash.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Longest meta directive that is recognized, such as "#unless"
+#define FOLDING_RANGES_MAX_DIRECTIVE 16
+
+// ---------------- folding_nesting_t ----------------
+// A pair of braces, parentheses, or brackets, or a branch of a meta condition,
+// as offsets into the buffer
+typedef struct {
+    tokenid_t opener;
+    length_t begin;       // Beginning of the opening token
+    length_t inner_begin; // End of the opening token
+    length_t inner_end;   // Beginning of the closing token
+    length_t end;         // End of the closing token
+    length_t parent;      // Innermost nesting that contains this one, or NAME_INDEX_NONE
+} folding_nesting_t;
+
+// ---------------- folding_document_t ----------------
+// Nestings of the last version of a file, in the order that they begin
+typedef struct {
+    strong_cstr_t filename;
+    hash_t hash;
+    length_t code_length;
+    length_t buffer_length;
+    line_index_t lines;
+    folding_nesting_t *nestings;
+    length_t nestings_length;
+    length_t nestings_capacity;
+
+    // Where each token is, for finding the token under a position
+    source_t *sources;
+    length_t sources_length;
+} folding_document_t;
+
+static folding_document_t *documents = NULL;
+static length_t documents_length = 0;
+static length_t documents_capacity = 0;
+static name_index_t documents_index;
+
+static folding_document_t *folding_ranges_find_document(weak_cstr_t filename){
+    if(documents == NULL) return NULL;
+
+    length_t found = name_index_find(&documents_index, filename);
+    return found != NAME_INDEX_NONE ? &documents[found] : NULL;
+}
+
+static folding_document_t *folding_ranges_document_for(weak_cstr_t filename){
+    folding_document_t *document = folding_ranges_find_document(filename);
+    if(document) return document;
+
+    if(documents == NULL) name_index_init(&documents_index);
+
+    expand((void**) &documents, sizeof(folding_document_t), documents_length, &documents_capacity, 1, 16);
+
+    documents[documents_length] = (folding_document_t){
+        .filename = strclone(filename),
+    };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&documents_index, documents[documents_length].filename);
+    return &documents[documents_length++];
+}
+
+static void folding_document_clear(folding_document_t *document){
+    if(document->nestings) line_index_free(&document->lines);
+    free(document->nestings);
+    free(document->sources);
+
+    document->nestings = NULL;
+    document->nestings_length = 0;
+    document->nestings_capacity = 0;
+    document->sources = NULL;
+    document->sources_length = 0;
+}
+
+static void folding_ranges_open(folding_document_t *document, length_t *stack, length_t *stack_length, tokenid_t opener, source_t source){
+    expand((void**) &document->nestings, sizeof(folding_nesting_t), document->nestings_length, &document->nestings_capacity, 1, 64);
+
+    document->nestings[document->nestings_length] = (folding_nesting_t){
+        .opener = opener,
+        .begin = source.index,
+        .inner_begin = source.index + source.stride,
+        .inner_end = document->buffer_length,
+        .end = document->buffer_length,
+        .parent = *stack_length ? stack[*stack_length - 1] : NAME_INDEX_NONE,
+    };
+
+    stack[(*stack_length)++] = document->nestings_length++;
+}
+
+static bool folding_ranges_close(folding_document_t *document, length_t *stack, length_t *stack_length, tokenid_t opener, length_t inner_end, length_t end){
+    // Closes the innermost nesting that was opened by a kind of token,
+    // which also closes anything left open within it, so that unbalanced code still folds
+    length_t position = *stack_length;
+
+    while(position != 0 && document->nestings[stack[position - 1]].opener != opener){
+        position--;
+    }
+
+    if(position == 0) return false;
+
+    while(*stack_length >= position){
+        folding_nesting_t *nesting = &document->nestings[stack[--(*stack_length)]];
+        nesting->inner_end = inner_end;
+        nesting->end = end;
+    }
+
+    return true;
+}
+
+static void folding_ranges_scan(folding_document_t *document, tokenlist_t *tokenlist, const char *buffer, length_t buffer_length){
+    // Nestings are found with a single pass over the tokens, keeping the open ones on a stack
+    document->buffer_length = buffer_length;
+    line_index_init(&document->lines, buffer, buffer_length);
+
+    document->sources = malloc(sizeof(source_t) * (tokenlist->length ? tokenlist->length : 1));
+    document->sources_length = tokenlist->length;
+    memcpy(document->sources, tokenlist->sources, sizeof(source_t) * tokenlist->length);
+
+    // Nothing can be nested deeper than the number of tokens
+    length_t *stack = malloc(sizeof(length_t) * (tokenlist->length ? tokenlist->length : 1));
+    length_t stack_length = 0;
+
+    // Files without any nestings still get a list, so that they're known to be scanned
+    expand((void**) &document->nestings, sizeof(folding_nesting_t), 0, &document->nestings_capacity, 1, 64);
+
+    for(length_t i = 0; i != tokenlist->length; i++){
+        source_t source = tokenlist->sources[i];
+        length_t source_end = source.index + source.stride;
+        char directive[FOLDING_RANGES_MAX_DIRECTIVE];
+
+        switch(tokenlist->tokens[i].id){
+        case TOKEN_BEGIN:
+        case TOKEN_OPEN:
+        case TOKEN_BRACKET_OPEN:
+            folding_ranges_open(document, stack, &stack_length, tokenlist->tokens[i].id, source);
+            break;
+        case TOKEN_END:
+            folding_ranges_close(document, stack, &stack_length, TOKEN_BEGIN, source.index, source_end);
+            break;
+        case TOKEN_CLOSE:
+            folding_ranges_close(document, stack, &stack_length, TOKEN_OPEN, source.index, source_end);
+            break;
+        case TOKEN_BRACKET_CLOSE:
+            folding_ranges_close(document, stack, &stack_length, TOKEN_BRACKET_OPEN, source.index, source_end);
+            break;
+        case TOKEN_META:
+            if(!token_range_word(tokenlist, buffer, i, directive, sizeof directive)) break;
+
+            if(streq(directive, "#if") || streq(directive, "#unless")){
+                folding_ranges_open(document, stack, &stack_length, TOKEN_META, source);
+            } else if(streq(directive, "#elif") || streq(directive, "#else")){
+                // Each branch is its own nesting, which ends where the next one begins
+                if(folding_ranges_close(document, stack, &stack_length, TOKEN_META, source.index, source.index)){
+                    folding_ranges_open(document, stack, &stack_length, TOKEN_META, source);
+                }
+            } else if(streq(directive, "#end")){
+                folding_ranges_close(document, stack, &stack_length, TOKEN_META, source.index, source_end);
+            }
+            break;
+        }
+    }
+
+    free(stack);
+}
+
+static folding_document_t *folding_ranges_get(query_t *query){
+    // Nestings are only found again when the code changes, so asking again for
+    // the same version of a file, such as for each selection range, costs nothing
+    length_t code_length = strlen(query->code);
+    hash_t hash = hash_data(query->code, code_length);
+    folding_document_t *document = folding_ranges_find_document(query->filename);
+
+    if(document && document->nestings && document->hash == hash && document->code_length == code_length){
+        return document;
+    }
+
+    // Only tokens are needed, so the code is lexed by itself,
+    // which leaves the compilation of the file around for the next query that parses it
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex_tokens(&compilation, query);
+
+    if(lex_errorcode || compilation.tokens == NULL){
+        // Keep the previous nestings until the code can be lexed again
+        compilation_finish(&compilation);
+        return document && document->nestings ? document : NULL;
+    }
+
+    object_t *object = compilation.tokens;
+
+    document = folding_ranges_document_for(query->filename);
+    folding_document_clear(document);
+    document->hash = hash;
+    document->code_length = code_length;
+    folding_ranges_scan(document, &object->tokenlist, object->buffer, object->buffer_length);
+
+    compilation_finish(&compilation);
+    return document;
+}
+
+static void build_folding_position(json_builder_t *builder, folding_document_t *document, length_t offset){
+    length_t line, character;
+    line_index_position(&document->lines, offset, &line, &character);
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, character);
+    json_build_object_end(builder);
+}
+
+static void build_folding_range(json_builder_t *builder, folding_document_t *document, length_t begin, length_t end){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "start");
+    build_folding_position(builder, document, begin);
+    json_build_next(builder);
+    json_build_object_key(builder, "end");
+    build_folding_position(builder, document, end);
+    json_build_object_end(builder);
+}
+
+void handle_folding_ranges_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Folding ranges query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Folding ranges query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Folding ranges query is missing field 'code'");
+        return;
+    }
+
+    folding_document_t *document = folding_ranges_get(query);
+    length_t ranges_length = 0;
+
+    json_build_array_start(builder);
+
+    for(length_t i = 0; document && i != document->nestings_length; i++){
+        folding_nesting_t *nesting = &document->nestings[i];
+
+        length_t start_line, end_line, character;
+        line_index_position(&document->lines, nesting->begin, &start_line, &character);
+        line_index_position(&document->lines, nesting->inner_end, &end_line, &character);
+
+        // The line that closes a nesting stays visible, so only nestings that span lines can fold
+        if(end_line < start_line + 2) continue;
+
+        if(ranges_length++ != 0) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, "startLine");
+        json_build_integer(builder, start_line);
+        json_build_next(builder);
+        json_build_object_key(builder, "endLine");
+        json_build_integer(builder, end_line - 1);
+
+        if(nesting->opener == TOKEN_META){
+            json_build_next(builder);
+            json_build_object_key(builder, "kind");
+            json_build_string(builder, "region");
+        }
+
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+}
+
+void handle_selection_ranges_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Selection ranges query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Selection ranges query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Selection ranges query is missing field 'code'");
+        return;
+    }
+
+    if(!query->has_range){
+        json_build_string(builder, "Selection ranges query is missing field 'range'");
+        return;
+    }
+
+    folding_document_t *document = folding_ranges_get(query);
+
+    if(document == NULL){
+        json_build_null(builder);
+        return;
+    }
+
+    length_t offset = line_index_offset(&document->lines, query->range_start_line, query->range_start_character);
+
+    // Ranges are given from innermost to outermost, and each contains the one before it
+    length_t begin = offset;
+    length_t end = offset;
+    length_t ranges_length = 0;
+
+    json_build_array_start(builder);
+
+    // The token under the position comes first, which is found by where tokens begin
+    length_t low = 0;
+    length_t high = document->sources_length;
+
+    while(low < high){
+        length_t middle = low + (high - low) / 2;
+
+        if(document->sources[middle].index <= offset){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if(low != 0){
+        source_t source = document->sources[low - 1];
+
+        if(offset <= source.index + source.stride && source.stride != 0){
+            begin = source.index;
+            end = source.index + source.stride;
+            ranges_length++;
+            build_folding_range(builder, document, begin, end);
+        }
+    }
+
+    // The innermost nesting that contains the position is the last one to begin before it that hasn't ended yet
+    low = 0;
+    high = document->nestings_length;
+
+    while(low < high){
+        length_t middle = low + (high - low) / 2;
+
+        if(document->nestings[middle].begin <= begin){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    length_t nesting_index = low != 0 ? low - 1 : NAME_INDEX_NONE;
+
+    while(nesting_index != NAME_INDEX_NONE && document->nestings[nesting_index].end < end){
+        nesting_index = document->nestings[nesting_index].parent;
+    }
+
+    // Each nesting gives what's within its delimiters, and then itself along with them
+    for(; nesting_index != NAME_INDEX_NONE; nesting_index = document->nestings[nesting_index].parent){
+        folding_nesting_t *nesting = &document->nestings[nesting_index];
+
+        // What's within a branch of a meta condition also has the condition, so only the whole branch is given
+        if(nesting->opener != TOKEN_META && nesting->inner_begin <= begin && nesting->inner_end >= end && nesting->inner_end - nesting->inner_begin > end - begin){
+            if(ranges_length++ != 0) json_build_next(builder);
+            begin = nesting->inner_begin;
+            end = nesting->inner_end;
+            build_folding_range(builder, document, begin, end);
+        }
+
+        if(nesting->begin <= begin && nesting->end >= end && nesting->end - nesting->begin > end - begin){
+            if(ranges_length++ != 0) json_build_next(builder);
+            begin = nesting->begin;
+            end = nesting->end;
+            build_folding_range(builder, document, begin, end);
+        }
+    }
+
+    // Everything is last
+    if(end - begin < document->buffer_length){
+        if(ranges_length != 0) json_build_next(builder);
+        build_folding_range(builder, document, 0, document->buffer_length);
+    }
+
+    json_build_array_end(builder);
+}
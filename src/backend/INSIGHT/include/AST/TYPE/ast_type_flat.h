@@ -0,0 +1,66 @@
+
+#ifndef _ISAAC_AST_TYPE_FLAT_H
+#define _ISAAC_AST_TYPE_FLAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ast_type_flat.h ============================
+    Definitions for flattened AST types
+
+    A flattened type stores all of its elements in one contiguous sequence
+    of words, with nested types (generic arguments, function pointer
+    arguments and return types, 'extends' types) encoded inline.
+    Comparing two is a single 'memcmp' and hashing one is a linear pass
+    without any pointer chasing, which is what 'ast_type_table_t' uses
+    them for when looking up canonical types
+
+    NOTE: Sources are not part of the encoding
+    NOTE: Unlike 'ast_types_identical', flattened types are only identical
+          when they are spelled exactly the same (e.g. 'usize' != 'ulong')
+    --------------------------------------------------------------------------
+*/
+
+#include "AST/ast_type_lean.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- ast_type_flat_t ----------------
+// An AST type flattened into a sequence of words
+typedef struct {
+    length_t *words;
+    length_t length;
+    length_t capacity;
+} ast_type_flat_t;
+
+// ---------------- ast_type_flatten_into ----------------
+// Flattens an AST type, reusing the memory of an existing flattened type
+// Fails if the type contains elements that cannot be flattened
+// (anonymous layouts, uncollapsed variable fixed arrays, and unknown enums)
+// NOTE: 'inout_flat' remains owned by the caller even when unsuccessful
+successful_t ast_type_flatten_into(const ast_type_t *type, ast_type_flat_t *inout_flat);
+
+// ---------------- ast_type_unflatten ----------------
+// Reconstructs a regular AST type from a flattened type
+// NOTE: All elements of the resulting type will have a NULL_SOURCE
+ast_type_t ast_type_unflatten(const ast_type_flat_t *flat, source_t source);
+
+// ---------------- ast_type_flats_identical ----------------
+// Returns whether two flattened types are identical
+bool ast_type_flats_identical(const ast_type_flat_t *a, const ast_type_flat_t *b);
+
+// ---------------- ast_type_flat_hash ----------------
+// Hashes a flattened type
+hash_t ast_type_flat_hash(const ast_type_flat_t *flat);
+
+// ---------------- ast_type_flat_free ----------------
+// Frees a flattened type
+void ast_type_flat_free(ast_type_flat_t *flat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_TYPE_FLAT_H
@@ -0,0 +1,76 @@
+
+#ifndef _ISAAC_AST_TYPE_TABLE_H
+#define _ISAAC_AST_TYPE_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ast_type_table.h ============================
+    Definitions for hash-consing AST types
+
+    Each distinct type is stored once as a canonical, immutable instance.
+    Two types interned into the same table are identical exactly when
+    their entries are the same pointer, and their hashes are cached.
+    --------------------------------------------------------------------------
+*/
+
+#include "AST/TYPE/ast_type_flat.h"
+#include "AST/ast_type_lean.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- ast_type_table_entry_t ----------------
+// A canonical type within a type table
+typedef struct {
+    ast_type_flat_t flat;
+    hash_t hash;
+    ast_type_t type;
+} ast_type_table_entry_t;
+
+// ---------------- ast_type_table_t ----------------
+// A hash-consing table of canonical types
+typedef struct {
+    ast_type_table_entry_t **entries;
+    length_t capacity;
+    length_t count;
+    ast_type_flat_t scratch;
+    arena_t *arena;
+} ast_type_table_t;
+
+// ---------------- ast_type_table_init ----------------
+// Initializes a type table
+// NOTE: Entries are allocated from 'arena', which must outlive the table
+void ast_type_table_init(ast_type_table_t *table, arena_t *arena);
+
+// ---------------- ast_type_table_free ----------------
+// Frees a type table along with all of its canonical types
+// NOTE: Memory of entries is left for the arena to release
+void ast_type_table_free(ast_type_table_t *table);
+
+// ---------------- ast_type_table_intern ----------------
+// Finds or inserts the canonical instance of a type
+// Returns NULL if the type cannot be flattened (see 'ast_type_flatten_into')
+ast_type_table_entry_t *ast_type_table_intern(ast_type_table_t *table, const ast_type_t *type);
+
+// ---------------- ast_type_table_canonicalize ----------------
+// Replaces a type with a reference to its canonical instance,
+// keeping only the original outer source
+// Returns whether the type was replaced
+// NOTE: The elements of a canonicalized type are owned by the table,
+//       so the type must never be modified or freed
+bool ast_type_table_canonicalize(ast_type_table_t *table, ast_type_t *inout_type);
+
+// ---------------- ast_type_table_canonicalize_all ----------------
+// Canonicalizes a list of types, either all of them or none of them
+// NOTE: Types without any elements are left as they are
+// Returns whether the types were replaced
+bool ast_type_table_canonicalize_all(ast_type_table_t *table, ast_type_t *types, length_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_TYPE_TABLE_H
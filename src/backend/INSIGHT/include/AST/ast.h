@@ -23,6 +23,7 @@ extern "C" {
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
+#include "UTIL/name_index.h"
 #include "UTIL/trait.h"
 
 struct compiler;
@@ -54,6 +55,10 @@ typedef struct {
 
     #ifdef ADEPT_INSIGHT_BUILD
     source_t end_source;
+    length_t body_token_index; // index of the opening '{' of the body, or 0 when there isn't one
+    length_t composite_association; // index of the composite whose domain the function is in, or (length_t) -1
+    bool composite_association_is_polymorphic;
+    bool is_signature_shared; // whether 'arg_types' and 'return_type' are owned by the type table of the compiler
     #endif
 } ast_func_t;
 
@@ -95,6 +100,7 @@ typedef struct {
 #define AST_FUNC_WARN_BAD_PRINTF_FORMAT TRAIT_2_5
 #define AST_FUNC_INIT                   TRAIT_2_6
 #define AST_FUNC_DEINIT                 TRAIT_2_7
+#define AST_FUNC_LAZY_BODY              TRAIT_2_8
 
 // ------------------ ast_func_prefixes_t ------------------
 // Information about the keywords that prefix a function
@@ -156,6 +162,10 @@ typedef struct {
     length_t generics_length;
     trait_t traits;
     source_t source;
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    bool is_type_shared; // whether 'type' is owned by the type table of the compiler
+    #endif
 } ast_alias_t;
 
 // ---------------- ast_global_t ----------------
@@ -250,6 +260,24 @@ typedef struct {
     ast_poly_composite_t *poly_composites;
     length_t poly_composites_length;
     length_t poly_composites_capacity;
+
+    // Indexes for looking up items by name
+    // NOTE: 'funcs_index' and 'meta_definitions_index' are caught up on lookup,
+    // since names of functions are set after they're created, and
+    // meta definitions are added without access to the AST
+    name_index_t funcs_index;
+    name_index_t composites_index;
+    name_index_t poly_composites_index;
+    name_index_t meta_definitions_index;
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Number of leading declarations of each kind that are linked from the prelude,
+    // which are shared and so are left alone when freeing (see 'prelude_link_ast')
+    length_t linked_composites_length;
+    length_t linked_aliases_length;
+    length_t linked_enums_length;
+    length_t linked_globals_length;
+    #endif
 } ast_t;
 
 #define LIBRARY_KIND_NONE           0x00
@@ -319,6 +347,21 @@ void ast_enum_init(ast_enum_t *enum_definition, weak_cstr_t name, weak_cstr_t *k
 // Finds a composite by its exact name
 ast_composite_t *ast_composite_find_exact(ast_t *ast, const char *name);
 
+// ---------------- ast_find_func ----------------
+// Finds the first function with a name
+// Returns INVALID_FUNC_ID if no such function exists
+func_id_t ast_find_func(ast_t *ast, const char *name);
+
+// ---------------- ast_find_next_func ----------------
+// Finds the next function with the same name as a function found via 'ast_find_func'
+// Returns INVALID_FUNC_ID if no such function exists
+func_id_t ast_find_next_func(ast_t *ast, func_id_t func_id);
+
+// ---------------- ast_find_meta_definition ----------------
+// Finds a meta definition by name
+// Returns NULL if no such meta definition exists
+meta_definition_t *ast_find_meta_definition(ast_t *ast, const char *name);
+
 // ---------------- ast_poly_composite_find_exact (and friends) ----------------
 // Finds a polymorphic composite by its exact name
 ast_poly_composite_t *ast_poly_composite_find_exact_from_elem(ast_t *ast, ast_elem_generic_base_t *elem);
@@ -14,6 +14,7 @@
 #include "AST/ast_type_lean.h"
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
+#include "UTIL/name_index.h"
 #include "UTIL/trait.h"
 
 // ---------------- AST_LAYOUT_ENDPOINT_END_INDEX ----------------
@@ -113,6 +114,9 @@ typedef struct {
 
     // Whether this field map doesn't contain any overlapping fields
     bool is_simple;
+
+    // Index of arrows by name, only used for larger field maps
+    name_index_t index;
 } ast_field_map_t;
 
 // ---------------- ast_field_map_init ----------------
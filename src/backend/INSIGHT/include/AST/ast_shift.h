@@ -0,0 +1,72 @@
+
+#ifndef _ISAAC_AST_SHIFT_H
+#define _ISAAC_AST_SHIFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== ast_shift.h ===============================
+    Module for moving the sources within an AST after the text of an object
+    was edited, so that an AST can be kept when only a single part of it is
+    parsed again
+
+    NOTE: Types owned by a type table are left alone, since they're shared
+    between declarations (see 'ast_type_table_canonicalize')
+    ---------------------------------------------------------------------------
+*/
+
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_type.h"
+#include "UTIL/ground.h"
+
+// ---------------- ast_shift_t ----------------
+// An edit to the text of an object, where the text
+// that ended at 'old_end' now ends at 'new_end'
+typedef struct {
+    length_t object_index;
+    length_t old_end;
+    length_t new_end;
+} ast_shift_t;
+
+// ---------------- ast_shift_source ----------------
+// Moves a source if it came after the edit
+void ast_shift_source(const ast_shift_t *shift, source_t *source);
+
+// ---------------- ast_shift_type ----------------
+// Moves the sources within an AST type that came after the edit
+void ast_shift_type(const ast_shift_t *shift, ast_type_t *type);
+
+// ---------------- ast_shift_types ----------------
+// Moves the sources within a list of AST types that came after the edit
+void ast_shift_types(const ast_shift_t *shift, ast_type_t *types, length_t length);
+
+// ---------------- ast_shift_layout ----------------
+// Moves the sources within the types of a layout that came after the edit
+void ast_shift_layout(const ast_shift_t *shift, ast_layout_t *layout);
+
+// ---------------- ast_shift_expr ----------------
+// Moves the sources within an expression that came after the edit
+// NOTE: 'expr' can be NULL
+void ast_shift_expr(const ast_shift_t *shift, ast_expr_t *expr);
+
+// ---------------- ast_shift_exprs ----------------
+// Moves the sources within a list of expressions that came after the edit
+void ast_shift_exprs(const ast_shift_t *shift, ast_expr_t **exprs, length_t length);
+
+// ---------------- ast_shift_expr_list ----------------
+// Moves the sources within a list of statements that came after the edit
+void ast_shift_expr_list(const ast_shift_t *shift, ast_expr_list_t *list);
+
+// ---------------- ast_shift_all ----------------
+// Moves every source within an AST that came after the edit
+void ast_shift_all(const ast_shift_t *shift, ast_t *ast);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_SHIFT_H
@@ -0,0 +1,33 @@
+#ifndef _ISAAC_PRELUDE_H
+#define _ISAAC_PRELUDE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ prelude.h =================================
+    Module for the declarations that every AST starts out with
+
+    The 'Any' types, the '__types__' globals and 'va_list' are the same for
+    every compilation, so they are constructed once per process and then
+    linked into each AST by reference instead of being rebuilt every time.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "AST/ast.h"
+#include "DRVR/compiler.h"
+
+// ---------------- prelude_link_ast ----------------
+// Adds the same declarations as 'any_inject_ast' and 'va_args_inject_ast'
+// NOTE: Linked declarations share their names, layouts and types with the prelude,
+//       so they must never be modified in place, and are left alone by 'ast_free'
+void prelude_link_ast(compiler_t *compiler, ast_t *ast);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_PRELUDE_H
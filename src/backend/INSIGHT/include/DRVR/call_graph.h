@@ -0,0 +1,106 @@
+#ifndef _ISAAC_CALL_GRAPH_H
+#define _ISAAC_CALL_GRAPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== call_graph.h ===============================
+    Process-wide graph of which functions call which other functions
+
+    Callee names are interned, and every function of a compiled file keeps
+    the calls within its body as edges sorted by callee. The edges of a
+    function are only found again when the text of the function changes,
+    so edits only cost as much as the functions that were edited.
+
+    Callers of each callee are found through a reverse index of every edge,
+    which is rebuilt on demand after the graph changes.
+
+    NOTE: Calls are resolved by name only, so functions that share a name
+          share their callers
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "AST/ast.h"
+#include "DRVR/compiler.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+
+// ---------------- call_graph_position_t ----------------
+// A zero-indexed position within a file
+typedef struct {
+    length_t line;
+    length_t character;
+} call_graph_position_t;
+
+// ---------------- call_graph_item_t ----------------
+// A function of the call graph
+typedef struct {
+    weak_cstr_t name;     // Borrowed from the graph, and valid forever
+    weak_cstr_t absolute; // Borrowed from the graph, and valid forever
+    call_graph_position_t begin;
+    call_graph_position_t end;
+    call_graph_position_t name_begin;
+    call_graph_position_t name_end;
+} call_graph_item_t;
+
+// ---------------- call_graph_call_t ----------------
+// A call between a function of the call graph and another
+typedef struct {
+    call_graph_item_t item; // The function on the other end of the call
+    call_graph_position_t begin;
+    call_graph_position_t end;
+} call_graph_call_t;
+
+// ---------------- call_graph_count_t ----------------
+// How many times a function calls functions of a name
+typedef struct {
+    weak_cstr_t name; // Borrowed from the graph, and valid forever
+    length_t count;
+} call_graph_count_t;
+
+// ---------------- call_graph_*_list_t ----------------
+// Lists of call graph results
+// NOTE: Only the array of a list has to be freed
+typedef listof(call_graph_item_t, items) call_graph_item_list_t;
+typedef listof(call_graph_call_t, calls) call_graph_call_list_t;
+typedef listof(call_graph_count_t, counts) call_graph_count_list_t;
+
+// ---------------- call_graph_update ----------------
+// Updates the functions of every file of a successfully parsed AST
+// Functions whose bodies haven't been parsed keep the edges from when they last were
+void call_graph_update(compiler_t *compiler, ast_t *ast);
+
+// ---------------- call_graph_forget ----------------
+// Forgets the functions of a file given its absolute filename
+void call_graph_forget(weak_cstr_t absolute);
+
+// ---------------- call_graph_find ----------------
+// Finds the functions that have a name
+call_graph_item_list_t call_graph_find(weak_cstr_t name);
+
+// ---------------- call_graph_incoming ----------------
+// Finds the calls to functions that have a name,
+// grouped by calling function, and in order within each
+// NOTE: Positions of the calls are within the calling function
+call_graph_call_list_t call_graph_incoming(weak_cstr_t name);
+
+// ---------------- call_graph_outgoing ----------------
+// Finds the calls made by the function that begins at a position,
+// grouped by called function, and in order within each
+// NOTE: Positions of the calls are within the calling function
+call_graph_call_list_t call_graph_outgoing(weak_cstr_t absolute, call_graph_position_t begin);
+
+// ---------------- call_graph_count ----------------
+// Counts the calls made by a function for each name that it calls, sorted by name
+// Only names of functions that are known to the graph are counted
+// NOTE: 'func' must belong to the AST that the graph was last updated with
+call_graph_count_list_t call_graph_count(compiler_t *compiler, ast_func_t *func);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_CALL_GRAPH_H
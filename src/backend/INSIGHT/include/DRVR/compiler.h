@@ -17,11 +17,14 @@ extern "C" {
 
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast_type_lean.h"
 #include "DRVR/config.h"
 #include "DRVR/object.h"
+#include "UTIL/arena.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
+#include "UTIL/name_index.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
 #include "UTIL/trait.h"
@@ -47,6 +50,7 @@ extern "C" {
 #define COMPILER_TYPE_COLON               TRAIT_2_3
 #define COMPILER_WINDOWED                 TRAIT_2_4
 #define COMPILER_OUTPUT_DYNAMIC_LIBRARY   TRAIT_2_5
+#define COMPILER_SKIP_IMPORTED_BODIES     TRAIT_2_6
 
 // Possible compiler trait checks
 #define COMPILER_NULL_CHECKS      TRAIT_1
@@ -96,6 +100,7 @@ typedef struct compiler {
     object_t **objects;
     length_t objects_length;
     length_t objects_capacity;
+    name_index_t objects_index; // Objects by absolute filename (see 'already_imported')
 
     // Compiler persistent configuration options
     config_t config;
@@ -132,6 +137,15 @@ typedef struct compiler {
 
     weak_cstr_t init_point;
     weak_cstr_t deinit_point;
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Arena for memory that lives as long as the compilation,
+    // which is released all at once by 'compiler_reset' and 'compiler_free'
+    arena_t arena;
+
+    // Canonical instances of types used in declarations (allocated from 'arena')
+    ast_type_table_t type_table;
+    #endif
 } compiler_t;
 
 #define CROSS_COMPILE_NONE    0x00
@@ -162,6 +176,13 @@ void compiler_init(compiler_t *compiler);
 // Frees data within a compiler
 void compiler_free(compiler_t *compiler);
 
+#ifdef ADEPT_INSIGHT_BUILD
+// ---------------- compiler_reset ----------------
+// Returns a compiler to the state it was in right after 'compiler_init',
+// while keeping the memory of its arena for reuse
+void compiler_reset(compiler_t *compiler);
+#endif
+
 // ---------------- compiler_free_objects ----------------
 // Frees objects of a compiler and resets 'objects_*' values
 void compiler_free_objects(compiler_t *compiler);
@@ -222,6 +243,7 @@ errorcode_t compiler_create_package(compiler_t *compiler, object_t *object);
 
 // ---------------- compiler_read_file ----------------
 // Reads either a package or adept code file into tokens for an object
+// In insight builds, unsaved contents from the overlay are preferred over the file on disk
 errorcode_t compiler_read_file(compiler_t *compiler, object_t *object);
 
 // ---------------- compiler_get_stdlib ----------------
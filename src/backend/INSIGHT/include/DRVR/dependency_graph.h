@@ -0,0 +1,46 @@
+#ifndef _ISAAC_DEPENDENCY_GRAPH_H
+#define _ISAAC_DEPENDENCY_GRAPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ dependency_graph.h ============================
+    Process-wide graph of which files import which other files
+
+    Imports are recorded as files are parsed, and the imports of a file are
+    forgotten right before it is parsed again, so the graph always reflects
+    the most recently parsed version of each file.
+
+    This is used to find which files have to be analyzed again
+    when a file changes, without analyzing everything again.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/string_list.h"
+
+// ---------------- dependency_graph_forget_imports ----------------
+// Forgets the imports of a file given its absolute filename
+void dependency_graph_forget_imports(weak_cstr_t importer);
+
+// ---------------- dependency_graph_add_import ----------------
+// Remembers that a file imports another file, given their absolute filenames
+void dependency_graph_add_import(weak_cstr_t importer, weak_cstr_t imported);
+
+// ---------------- dependency_graph_dependents ----------------
+// Finds the files that import any of the given files, either directly or indirectly
+// The files are ordered so that each file comes after the files it imports,
+// which is the order they should be analyzed again in
+// NOTE: The given files themselves are never included
+// NOTE: 'absolutes' are absolute filenames
+strong_cstr_list_t dependency_graph_dependents(const strong_cstr_list_t *absolutes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_DEPENDENCY_GRAPH_H
@@ -0,0 +1,54 @@
+#ifndef _ISAAC_FILE_CACHE_H
+#define _ISAAC_FILE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== file_cache.h ===============================
+    Process-wide cache of the contents of files
+
+    Contents are only cached for files whose directories are being watched,
+    so that they can be reused without touching the filesystem until
+    the file watcher reports that they changed.
+
+    Cached contents are lent out without being copied. Contents of files
+    that are never edited in place, such as those of the infrastructure, are
+    memory-mapped, while the contents of other files are read into memory,
+    since a file that shrinks under a mapping can't be read anymore.
+    Contents that are forgotten while still borrowed are kept
+    until they are returned with 'file_cache_release'.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// ---------------- file_cache_text_contents ----------------
+// Gets the text contents of a file in the same way as 'file_text_contents' with 'append_newline',
+// reusing the contents that were read previously when the file is known to be unchanged
+// NOTE: 'absolute' is the absolute filename of 'filename', and is used to identify the file
+// NOTE: 'is_immutable' is whether the file is never edited in place, which allows it to be memory-mapped
+// NOTE: If 'out_borrowed' is set to true, 'out_contents' is read-only and must be
+//       returned using 'file_cache_release', otherwise it must be freed by the caller
+bool file_cache_text_contents(weak_cstr_t filename, weak_cstr_t absolute, bool is_immutable, strong_cstr_t *out_contents, length_t *out_length, bool *out_borrowed);
+
+// ---------------- file_cache_release ----------------
+// Returns contents that were borrowed from 'file_cache_text_contents'
+void file_cache_release(weak_cstr_t absolute, const char *contents);
+
+// ---------------- file_cache_invalidate ----------------
+// Forgets the cached contents of a file given its absolute filename
+void file_cache_invalidate(weak_cstr_t absolute);
+
+// ---------------- file_cache_clear ----------------
+// Forgets the cached contents of all files
+void file_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_FILE_CACHE_H
@@ -0,0 +1,50 @@
+#ifndef _ISAAC_IMPORT_CACHE_H
+#define _ISAAC_IMPORT_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== import_cache.h ==============================
+    Process-wide cache of which files that imports could resolve to exist
+
+    Every candidate filename of an import is remembered by its directory and
+    name, along with whether it exists and its absolute filename. Missing
+    candidates are remembered as well, since most imports have to skip over
+    a few of them.
+
+    Results for files in directories that the file watcher is watching are
+    trusted as-is until the file watcher reports a change to them, so
+    resolving an import usually doesn't touch the filesystem at all.
+    Other results are validated using 'stat' before being reused, which
+    still avoids resolving absolute filenames again for every query.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/string_list.h"
+
+// ---------------- import_cache_resolve ----------------
+// Finds the first candidate filename of an import that exists
+// Returns the index of the candidate, or -1 if none of them exist
+// NOTE: '*out_absolute' is set to a new string that must be freed by the caller,
+// or to NULL if the absolute filename of the candidate couldn't be determined
+// NOTE: Absolute filenames of the candidates that were skipped over are appended to 'out_missing'
+maybe_index_t import_cache_resolve(const strong_cstr_list_t *candidates, maybe_null_strong_cstr_t *out_absolute, strong_cstr_list_t *out_missing);
+
+// ---------------- import_cache_invalidate ----------------
+// Forgets what is known about a file, such as when it's created or removed
+void import_cache_invalidate(weak_cstr_t filename);
+
+// ---------------- import_cache_clear ----------------
+// Forgets everything that is known about every file
+void import_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IMPORT_CACHE_H
@@ -15,6 +15,7 @@ extern "C" {
 #include "AST/ast.h"
 #include "LEX/token.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "UTIL/trait.h"
 
 #ifndef ADEPT_INSIGHT_BUILD
@@ -43,6 +44,14 @@ typedef struct object {
 
     #ifndef ADEPT_INSIGHT_BUILD
     ir_module_t ir_module;       // Intermediate-Representation module
+    #else
+    hash_t buffer_hash;          // Hash of text buffer (set when lexed)
+
+    // Token lists replaced by reparsing a function body,
+    // which are kept since the AST can still point into their data
+    tokenlist_t *retired_tokenlists;
+    length_t retired_tokenlists_length;
+    length_t retired_tokenlists_capacity;
     #endif
 
     int compilation_stage;       // Compilation stage
@@ -59,6 +68,7 @@ typedef struct object {
 // Possible traits for object_t
 #define OBJECT_NONE    TRAIT_NONE
 #define OBJECT_PACKAGE TRAIT_1    // Is an imported package
+#define OBJECT_BORROWED_BUFFER TRAIT_2 // Text buffer is borrowed from the file cache (insight only)
 
 // ------------------ object_init_ast ------------------
 // Initializes the AST portion of an object_t
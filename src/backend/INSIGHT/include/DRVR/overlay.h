@@ -0,0 +1,55 @@
+#ifndef _ISAAC_OVERLAY_H
+#define _ISAAC_OVERLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ overlay.h =================================
+    Process-wide overlay of unsaved file contents
+
+    Documents that are open in the editor have their latest contents kept here,
+    so that other files which import them see the unsaved contents instead of
+    reading stale contents from disk.
+
+    Changing the contents of a file reports the change to the file watcher,
+    which causes anything cached about the file to be forgotten. Unsaved
+    changes are reported as such, since the file on disk stays the same.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// ---------------- overlay_set ----------------
+// Sets the unsaved contents of a file given its absolute filename
+// NOTE: 'contents' must be terminated with '\n\0' (where '\0' is not included in 'length')
+// NOTE: Setting the same contents again does nothing
+void overlay_set(weak_cstr_t absolute, const char *contents, length_t length);
+
+// ---------------- overlay_remove ----------------
+// Forgets the unsaved contents of a file given its absolute filename,
+// so that its contents are read from disk again
+void overlay_remove(weak_cstr_t absolute);
+
+// ---------------- overlay_text_contents ----------------
+// Gets the unsaved contents of a file given its absolute filename
+// Returns whether the file has unsaved contents
+// NOTE: 'out_contents' is set to a new string that must be freed by the caller
+bool overlay_text_contents(weak_cstr_t absolute, strong_cstr_t *out_contents, length_t *out_length);
+
+// ---------------- overlay_exists ----------------
+// Returns whether a file has unsaved contents, which is the case while it's open
+bool overlay_exists(weak_cstr_t absolute);
+
+// ---------------- overlay_matches ----------------
+// Returns whether a file has unsaved contents that are the same as 'contents'
+bool overlay_matches(weak_cstr_t absolute, const char *contents, length_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_OVERLAY_H
@@ -0,0 +1,69 @@
+#ifndef _ISAAC_REFERENCE_INDEX_H
+#define _ISAAC_REFERENCE_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= reference_index.h =============================
+    Process-wide index of where each identifier appears in each file
+
+    Identifiers are interned for as long as any file uses them, and every
+    file that has been lexed keeps a list of postings (identifier, location)
+    sorted by identifier, which is replaced whenever the file is lexed again
+    with different contents.
+
+    This allows finding references across every file that has been compiled
+    without lexing or parsing anything again.
+
+    NOTE: References are found by name only, so different symbols that share
+          a name share their references
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/list.h"
+
+// ---------------- reference_t ----------------
+// Where an identifier appears, as zero-indexed lines and characters
+typedef struct {
+    weak_cstr_t absolute; // Borrowed from the index, and valid forever
+    length_t line;
+    length_t character;
+    length_t stride;
+    bool is_declaration;
+} reference_t;
+
+// ---------------- reference_list_t ----------------
+// A list of references
+typedef listof(reference_t, references) reference_list_t;
+#define reference_list_append(LIST, VALUE) list_append((LIST), (VALUE), reference_t)
+
+// ---------------- reference_list_free ----------------
+// Frees a list of references
+void reference_list_free(reference_list_t *list);
+
+// ---------------- reference_index_update ----------------
+// Indexes the identifiers of a freshly lexed file, given its absolute filename
+// NOTE: Words must still have their data, so this has to happen before parsing
+void reference_index_update(weak_cstr_t absolute, tokenlist_t *tokenlist, const char *buffer, text_version_t version);
+
+// ---------------- reference_index_forget ----------------
+// Forgets the identifiers of a file given its absolute filename
+void reference_index_forget(weak_cstr_t absolute);
+
+// ---------------- reference_index_find ----------------
+// Finds where an identifier appears, optionally only within a single file
+// References are grouped by file, and are in order within each file
+// NOTE: 'only_absolute' is the absolute filename of the file, or NULL for every file
+reference_list_t reference_index_find(weak_cstr_t name, maybe_null_weak_cstr_t only_absolute);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_REFERENCE_INDEX_H
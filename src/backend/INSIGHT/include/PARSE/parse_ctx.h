@@ -54,6 +54,10 @@ typedef struct {
     // Token ID required to close struct definition
     tokenid_t struct_closer;
     char struct_closer_char;
+
+    // Used to only parse declarations of imported objects,
+    // function bodies are brace-matched and left to be parsed lazily
+    bool skip_func_bodies;
 } parse_ctx_t;
 
 // ------------------ parse_ctx_init ------------------
@@ -10,6 +10,7 @@ extern "C" {
 
 #include "PARSE/parse_ctx.h"
 #include "UTIL/ground.h"
+#include "UTIL/string_list.h"
 
 // ------------------ parse_import ------------------
 // Parses an 'import' statement
@@ -27,6 +28,10 @@ errorcode_t parse_foreign_library(parse_ctx_t* ctx);
 // Imports an object given the relative and absolute filenames
 errorcode_t parse_import_object(parse_ctx_t *ctx, strong_cstr_t relative_filename, strong_cstr_t absolute_filename);
 
+// ------------------ parse_import_candidates ------------------
+// Creates the list of filenames to try for an import, in order of preference
+strong_cstr_list_t parse_import_candidates(parse_ctx_t *ctx, weak_cstr_t filename, bool allow_local_import);
+
 // ------------------ parse_find_import ------------------
 // Finds the best file to use given a filename
 // NOTE: Returns NULL on error
@@ -41,6 +46,12 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
 // NOTE: Returns NULL on error
 maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t filename);
 
+// ------------------ parse_locate_import ------------------
+// Finds the best file to use given a filename, and its absolute filename
+// NOTE: Resolutions are cached across compilations for insight builds
+// NOTE: 'out_target' and 'out_absolute' are only set on success
+errorcode_t parse_locate_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import, strong_cstr_t *out_target, strong_cstr_t *out_absolute);
+
 // ------------------ already_imported ------------------
 // Returns whether or not the file has already been imported
 bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename);
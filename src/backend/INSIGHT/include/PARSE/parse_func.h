@@ -33,6 +33,26 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
 // Parses the body of a function
 errorcode_t parse_func_body(parse_ctx_t *ctx, ast_func_t *func);
 
+#ifdef ADEPT_INSIGHT_BUILD
+// ------------------ parse_func_skip_body ------------------
+// Brace-matches over the body of a function without parsing it,
+// the body can later be parsed on demand via 'parse_func_lazy_body'
+// NOTE: Bodies that contain meta directives are parsed right away instead
+// NOTE: Ends on 'i' pointing to the closing '}' token
+errorcode_t parse_func_skip_body(parse_ctx_t *ctx, ast_func_t *func);
+
+// ------------------ parse_func_lazy_body ------------------
+// Parses the skipped body of a function, if it has one
+// NOTE: 'ast' is the AST that the function belongs to
+errorcode_t parse_func_lazy_body(compiler_t *compiler, ast_t *ast, func_id_t func_id);
+
+// ------------------ parse_func_reparse_body ------------------
+// Parses the body of a function again from its current tokens,
+// replacing its existing statements
+// NOTE: The function must have a '{' body (see 'body_token_index')
+errorcode_t parse_func_reparse_body(compiler_t *compiler, ast_t *ast, func_id_t func_id);
+#endif
+
 // ------------------ parse_func_arguments ------------------
 // Parses the arguments that a function takes
 errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func);
@@ -0,0 +1,63 @@
+#ifndef _ISAAC_ARENA_H
+#define _ISAAC_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ arena.h ================================
+    Module for chunked bump allocation
+
+    Memory is explicitly allocated from an arena with 'arena_alloc',
+    and is never freed individually. It is instead released all at once
+    by 'arena_reset' or 'arena_free'.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+
+// ---------------- arena_chunk_t ----------------
+// A single block of memory that allocations are bumped out of
+typedef struct arena_chunk {
+    struct arena_chunk *prev;
+    char *end;
+} arena_chunk_t;
+
+// ---------------- arena_t ----------------
+// A chunked bump allocator
+typedef struct {
+    arena_chunk_t *chunk;
+    char *cursor;
+    size_t next_chunk_size;
+} arena_t;
+
+// ---------------- arena_init ----------------
+// Initializes an arena
+void arena_init(arena_t *arena);
+
+// ---------------- arena_free ----------------
+// Releases all memory owned by an arena
+void arena_free(arena_t *arena);
+
+// ---------------- arena_reset ----------------
+// Releases all allocations made from an arena while keeping its memory,
+// so that it can be reused without going back to the heap
+// NOTE: Chunks are merged into a single chunk that is large enough for
+//       everything that was allocated, so the arena stops growing once
+//       it has seen its largest use
+void arena_reset(arena_t *arena);
+
+// ---------------- arena_alloc ----------------
+// Allocates memory from an arena
+void *arena_alloc(arena_t *arena, size_t size);
+
+// ---------------- arena_memclone ----------------
+// Allocates a copy of memory from an arena
+void *arena_memclone(arena_t *arena, const void *memory, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_ARENA_H
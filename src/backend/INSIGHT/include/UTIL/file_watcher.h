@@ -0,0 +1,65 @@
+#ifndef _ISAAC_FILE_WATCHER_H
+#define _ISAAC_FILE_WATCHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== file_watcher.h ==============================
+    Module for noticing when files change on disk
+
+    Directories are watched using inotify on Linux, so that information
+    cached about the files within them can be trusted without touching the
+    filesystem until a change is reported. Changes can also be reported
+    manually, for example when a client tells us about them.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+
+// ---------------- file_change_t ----------------
+// A change to a file
+typedef struct {
+    maybe_null_strong_cstr_t filename; // NULL when anything could have changed
+    bool existence; // Whether the file was created or removed, rather than modified
+    bool is_unsaved; // Whether only the unsaved contents of the file changed, rather than the file on disk
+} file_change_t;
+
+// ---------------- file_change_list_t ----------------
+// A list of changes to files
+typedef listof(file_change_t, changes) file_change_list_t;
+
+// ---------------- file_watcher_watch ----------------
+// Watches the directory that contains a file
+// Returns whether changes to the file will be noticed without being reported manually
+// NOTE: Directories that are already being watched are remembered,
+// so this doesn't touch the filesystem after the first time
+bool file_watcher_watch(weak_cstr_t filename);
+
+// ---------------- file_watcher_notify ----------------
+// Manually reports a change to a file
+// NOTE: 'filename' can be NULL to report that anything could have changed
+void file_watcher_notify(maybe_null_weak_cstr_t filename, bool existence);
+
+// ---------------- file_watcher_notify_unsaved ----------------
+// Manually reports a change to the unsaved contents of a file, which leaves the file on disk the same
+void file_watcher_notify_unsaved(weak_cstr_t filename);
+
+// ---------------- file_watcher_poll ----------------
+// Collects the changes that happened since the last poll without blocking
+// NOTE: The returned list must be freed with 'file_change_list_free'
+file_change_list_t file_watcher_poll(void);
+
+// ---------------- file_change_list_free ----------------
+// Frees a list of changes to files
+void file_change_list_free(file_change_list_t *list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_FILE_WATCHER_H
@@ -46,6 +46,12 @@ strong_cstr_t filename_ext(const char *filename, const char *ext_without_dot);
 // Gets the absolute filename for a filename
 strong_cstr_t filename_absolute(const char *filename);
 
+// ---------------- filename_absolute_maybe_missing ----------------
+// Gets the absolute filename for a filename that may not exist,
+// as long as the folder that would contain it does
+// Returns NULL if the folder doesn't exist either
+maybe_null_strong_cstr_t filename_absolute_maybe_missing(const char *filename);
+
 // ---------------- filename_auto_ext ----------------
 // Append the correct file extension for the given
 // mode if '*out_filename' doesn't already have it
@@ -32,6 +32,24 @@ hash_t hash_strings(char *strings[], length_t num_strings);
 // Combines two hashes into one
 hash_t hash_combine(hash_t h1, hash_t h2);
 
+// ---------------- text_version_t ----------------
+// Identifies the contents of a file, so that caches
+// kept per file can tell when it has changed
+// NOTE: A zeroed version is unknown, and is never current
+typedef struct {
+    hash_t hash;
+    length_t length;
+    bool is_known;
+} text_version_t;
+
+// ---------------- text_version ----------------
+// Creates the version of text given its hash and length
+text_version_t text_version(hash_t hash, length_t length);
+
+// ---------------- text_version_is_current ----------------
+// Returns whether a cached version is known and is the same as the current version
+bool text_version_is_current(const text_version_t *cached, text_version_t current);
+
 #ifdef __cplusplus
 }
 #endif
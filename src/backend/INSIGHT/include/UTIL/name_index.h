@@ -0,0 +1,77 @@
+
+#ifndef _ISAAC_NAME_INDEX_H
+#define _ISAAC_NAME_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== name_index.h ===============================
+    Module for indexing the items of an array by name
+
+    Items are identified by their position in the array, and must be added
+    in order starting from zero. Items that share a name are chained
+    together in the order that they were added, so walking the matches
+    of a name visits them in the same order as a linear scan would.
+
+    NOTE: Names are borrowed, and must outlive the index without changing
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+#define NAME_INDEX_NONE ((length_t) -1)
+
+// ---------------- name_index_bucket_t ----------------
+// The items of a name index that share a single name
+typedef struct {
+    weak_cstr_t name; // NULL when unused
+    hash_t hash;
+    length_t first;
+    length_t last;
+} name_index_bucket_t;
+
+// ---------------- name_index_t ----------------
+// An index of the names of items in an array
+typedef struct {
+    name_index_bucket_t *buckets;
+    length_t buckets_capacity;
+    length_t buckets_used;
+
+    // Next item with the same name, for each item
+    length_t *next;
+    length_t length;
+    length_t capacity;
+} name_index_t;
+
+// ---------------- name_index_init ----------------
+// Initializes a name index
+void name_index_init(name_index_t *index);
+
+// ---------------- name_index_free ----------------
+// Frees a name index
+void name_index_free(name_index_t *index);
+
+// ---------------- name_index_add ----------------
+// Adds the next item to a name index
+// The item will be identified by 'index->length'
+// NOTE: Items without a name (NULL) can be added, but won't be found
+void name_index_add(name_index_t *index, maybe_null_weak_cstr_t name);
+
+// ---------------- name_index_find ----------------
+// Finds the first item with a name
+// Returns NAME_INDEX_NONE if no such item exists
+length_t name_index_find(const name_index_t *index, const char *name);
+
+// ---------------- name_index_next ----------------
+// Finds the next item with the same name as an item
+// Returns NAME_INDEX_NONE if no such item exists
+length_t name_index_next(const name_index_t *index, length_t item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_NAME_INDEX_H
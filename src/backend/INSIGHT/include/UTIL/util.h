@@ -56,6 +56,21 @@ bool file_exists(weak_cstr_t filename);
 // Returns whether successful
 bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length, bool append_newline);
 
+// ---------------- file_text_map ----------------
+// Maps text contents of a file into read-only memory.
+// The contents are terminated the same way as 'file_text_contents'
+// with 'append_newline', but pages are shared with the file instead of copied.
+// Falls back to reading the file on platforms without 'mmap'.
+// Reading the contents after the file shrinks is an error,
+// so only files that are never edited in place should be mapped.
+// Returns whether successful
+// NOTE: The contents must be released with 'file_text_unmap'
+bool file_text_map(weak_cstr_t filename, const char **out_contents, length_t *out_length);
+
+// ---------------- file_text_unmap ----------------
+// Releases text contents that were mapped using 'file_text_map'
+void file_text_unmap(const char *contents, length_t length);
+
 // ---------------- file_binary_contents ----------------
 // Reads binary contents of a file.
 // When successful, 'out_contents' will be a newly allocated
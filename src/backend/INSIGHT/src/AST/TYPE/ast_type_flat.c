@@ -0,0 +1,321 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/TYPE/ast_type_flat.h"
+#include "AST/ast_type.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
+#include "UTIL/util.h"
+
+#define WORD_SIZE sizeof(length_t)
+
+static void flat_push(ast_type_flat_t *flat, length_t word){
+    expand((void**) &flat->words, sizeof(length_t), flat->length, &flat->capacity, 1, 16);
+    flat->words[flat->length++] = word;
+}
+
+static void flat_push_string(ast_type_flat_t *flat, const char *string){
+    length_t size = strlen(string);
+    length_t num_words = (size + WORD_SIZE - 1) / WORD_SIZE;
+
+    flat_push(flat, size);
+    expand((void**) &flat->words, sizeof(length_t), flat->length, &flat->capacity, num_words, 16);
+
+    // Zero padding keeps the encoding comparable with 'memcmp'
+    if(num_words) flat->words[flat->length + num_words - 1] = 0;
+    memcpy(&flat->words[flat->length], string, size);
+    flat->length += num_words;
+}
+
+static void flat_push_strings(ast_type_flat_t *flat, const strong_cstr_list_t *strings){
+    flat_push(flat, strings->length);
+
+    for(length_t i = 0; i != strings->length; i++){
+        flat_push_string(flat, strings->items[i]);
+    }
+}
+
+static successful_t flat_push_type(ast_type_flat_t *flat, const ast_type_t *type);
+
+static successful_t flat_push_types(ast_type_flat_t *flat, const ast_type_t *types, length_t length){
+    for(length_t i = 0; i != length; i++){
+        if(!flat_push_type(flat, &types[i])) return false;
+    }
+    return true;
+}
+
+static successful_t flat_push_elem(ast_type_flat_t *flat, const ast_elem_t *elem){
+    flat_push(flat, elem->id);
+
+    switch(elem->id){
+    case AST_ELEM_BASE:
+        flat_push_string(flat, ((ast_elem_base_t*) elem)->base);
+        return true;
+    case AST_ELEM_POINTER:
+        flat_push(flat, ((ast_elem_pointer_t*) elem)->is_volatile);
+        return true;
+    case AST_ELEM_ARRAY:
+    case AST_ELEM_GENERIC_INT:
+    case AST_ELEM_GENERIC_FLOAT:
+        return true;
+    case AST_ELEM_FIXED_ARRAY:
+        flat_push(flat, ((ast_elem_fixed_array_t*) elem)->length);
+        return true;
+    case AST_ELEM_FUNC: {
+            ast_elem_func_t *func = (ast_elem_func_t*) elem;
+            flat_push(flat, func->traits);
+            flat_push(flat, func->arity);
+            return flat_push_type(flat, func->return_type) && flat_push_types(flat, func->arg_types, func->arity);
+        }
+    case AST_ELEM_POLYMORPH: {
+            ast_elem_polymorph_t *polymorph = (ast_elem_polymorph_t*) elem;
+            flat_push(flat, polymorph->allow_auto_conversion);
+            flat_push_string(flat, polymorph->name);
+            return true;
+        }
+    case AST_ELEM_POLYCOUNT:
+        flat_push_string(flat, ((ast_elem_polycount_t*) elem)->name);
+        return true;
+    case AST_ELEM_POLYMORPH_PREREQ: {
+            ast_elem_polymorph_prereq_t *prereq = (ast_elem_polymorph_prereq_t*) elem;
+            flat_push(flat, prereq->allow_auto_conversion);
+            flat_push_string(flat, prereq->name);
+            flat_push(flat, prereq->similarity_prerequisite != NULL);
+            if(prereq->similarity_prerequisite) flat_push_string(flat, prereq->similarity_prerequisite);
+            return flat_push_type(flat, &prereq->extends);
+        }
+    case AST_ELEM_GENERIC_BASE: {
+            ast_elem_generic_base_t *generic_base = (ast_elem_generic_base_t*) elem;
+            flat_push(flat, generic_base->name_is_polymorphic);
+            flat_push_string(flat, generic_base->name);
+            flat_push(flat, generic_base->generics_length);
+            return flat_push_types(flat, generic_base->generics, generic_base->generics_length);
+        }
+    case AST_ELEM_UNKNOWN_PLURAL_ENUM:
+        flat_push_strings(flat, &((ast_elem_unknown_plural_enum_t*) elem)->kinds);
+        return true;
+    case AST_ELEM_ANONYMOUS_ENUM:
+        flat_push_strings(flat, &((ast_elem_anonymous_enum_t*) elem)->kinds);
+        return true;
+    case AST_ELEM_LAYOUT:
+    case AST_ELEM_VAR_FIXED_ARRAY:
+    case AST_ELEM_UNKNOWN_ENUM:
+        return false;
+    default:
+        die("ast_type_flatten_into() - Unrecognized type element ID 0x%08X\n", elem->id);
+    }
+
+    return false;
+}
+
+static successful_t flat_push_type(ast_type_flat_t *flat, const ast_type_t *type){
+    flat_push(flat, type->elements_length);
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        if(!flat_push_elem(flat, type->elements[i])) return false;
+    }
+    return true;
+}
+
+successful_t ast_type_flatten_into(const ast_type_t *type, ast_type_flat_t *inout_flat){
+    inout_flat->length = 0;
+    return flat_push_type(inout_flat, type);
+}
+
+typedef struct {
+    const length_t *words;
+    length_t i;
+} flat_reader_t;
+
+static strong_cstr_t flat_read_string(flat_reader_t *reader){
+    length_t size = reader->words[reader->i++];
+    strong_cstr_t string = malloc(size + 1);
+
+    memcpy(string, &reader->words[reader->i], size);
+    string[size] = '\0';
+
+    reader->i += (size + WORD_SIZE - 1) / WORD_SIZE;
+    return string;
+}
+
+static strong_cstr_list_t flat_read_strings(flat_reader_t *reader){
+    length_t length = reader->words[reader->i++];
+
+    strong_cstr_list_t strings = (strong_cstr_list_t){
+        .items = malloc(sizeof(strong_cstr_t) * length),
+        .length = length,
+        .capacity = length,
+    };
+
+    for(length_t i = 0; i != length; i++){
+        strings.items[i] = flat_read_string(reader);
+    }
+    return strings;
+}
+
+static ast_type_t flat_read_type(flat_reader_t *reader);
+
+static ast_type_t *flat_read_types(flat_reader_t *reader, length_t length){
+    ast_type_t *types = malloc(sizeof(ast_type_t) * length);
+
+    for(length_t i = 0; i != length; i++){
+        types[i] = flat_read_type(reader);
+    }
+    return types;
+}
+
+static ast_elem_t *flat_read_elem(flat_reader_t *reader){
+    unsigned int id = reader->words[reader->i++];
+
+    switch(id){
+    case AST_ELEM_BASE:
+        return (ast_elem_t*) malloc_init(ast_elem_base_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .base = flat_read_string(reader),
+        });
+    case AST_ELEM_POINTER:
+        return (ast_elem_t*) malloc_init(ast_elem_pointer_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .is_volatile = reader->words[reader->i++],
+        });
+    case AST_ELEM_ARRAY:
+    case AST_ELEM_GENERIC_INT:
+    case AST_ELEM_GENERIC_FLOAT:
+        return malloc_init(ast_elem_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+        });
+    case AST_ELEM_FIXED_ARRAY:
+        return (ast_elem_t*) malloc_init(ast_elem_fixed_array_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .length = reader->words[reader->i++],
+        });
+    case AST_ELEM_FUNC: {
+            trait_t traits = reader->words[reader->i++];
+            length_t arity = reader->words[reader->i++];
+            ast_type_t *return_type = flat_read_types(reader, 1);
+
+            return (ast_elem_t*) malloc_init(ast_elem_func_t, {
+                .id = id,
+                .source = NULL_SOURCE,
+                .return_type = return_type,
+                .arg_types = flat_read_types(reader, arity),
+                .arity = arity,
+                .traits = traits,
+                .ownership = true,
+            });
+        }
+    case AST_ELEM_POLYMORPH: {
+            bool allow_auto_conversion = reader->words[reader->i++];
+
+            return (ast_elem_t*) malloc_init(ast_elem_polymorph_t, {
+                .id = id,
+                .source = NULL_SOURCE,
+                .name = flat_read_string(reader),
+                .allow_auto_conversion = allow_auto_conversion,
+            });
+        }
+    case AST_ELEM_POLYCOUNT:
+        return (ast_elem_t*) malloc_init(ast_elem_polycount_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .name = flat_read_string(reader),
+        });
+    case AST_ELEM_POLYMORPH_PREREQ: {
+            bool allow_auto_conversion = reader->words[reader->i++];
+            strong_cstr_t name = flat_read_string(reader);
+            bool has_similarity_prerequisite = reader->words[reader->i++];
+            strong_cstr_t similarity_prerequisite = has_similarity_prerequisite ? flat_read_string(reader) : NULL;
+
+            return (ast_elem_t*) malloc_init(ast_elem_polymorph_prereq_t, {
+                .id = id,
+                .source = NULL_SOURCE,
+                .name = name,
+                .allow_auto_conversion = allow_auto_conversion,
+                .similarity_prerequisite = similarity_prerequisite,
+                .extends = flat_read_type(reader),
+            });
+        }
+    case AST_ELEM_GENERIC_BASE: {
+            bool name_is_polymorphic = reader->words[reader->i++];
+            strong_cstr_t name = flat_read_string(reader);
+            length_t generics_length = reader->words[reader->i++];
+
+            return (ast_elem_t*) malloc_init(ast_elem_generic_base_t, {
+                .id = id,
+                .source = NULL_SOURCE,
+                .name = name,
+                .generics = flat_read_types(reader, generics_length),
+                .generics_length = generics_length,
+                .name_is_polymorphic = name_is_polymorphic,
+            });
+        }
+    case AST_ELEM_UNKNOWN_PLURAL_ENUM:
+        return (ast_elem_t*) malloc_init(ast_elem_unknown_plural_enum_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .kinds = flat_read_strings(reader),
+        });
+    case AST_ELEM_ANONYMOUS_ENUM:
+        return (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+            .id = id,
+            .source = NULL_SOURCE,
+            .kinds = flat_read_strings(reader),
+        });
+    default:
+        die("ast_type_unflatten() - Unrecognized type element ID 0x%08X\n", id);
+    }
+
+    return NULL;
+}
+
+static ast_type_t flat_read_type(flat_reader_t *reader){
+    length_t elements_length = reader->words[reader->i++];
+    ast_elem_t **elements = elements_length ? malloc(sizeof(ast_elem_t*) * elements_length) : NULL;
+
+    for(length_t i = 0; i != elements_length; i++){
+        elements[i] = flat_read_elem(reader);
+    }
+
+    return (ast_type_t){
+        .elements = elements,
+        .elements_length = elements_length,
+        .source = NULL_SOURCE,
+    };
+}
+
+ast_type_t ast_type_unflatten(const ast_type_flat_t *flat, source_t source){
+    flat_reader_t reader = (flat_reader_t){
+        .words = flat->words,
+        .i = 0,
+    };
+
+    ast_type_t type = flat_read_type(&reader);
+    type.source = source;
+    return type;
+}
+
+bool ast_type_flats_identical(const ast_type_flat_t *a, const ast_type_flat_t *b){
+    return a->length == b->length && memcmp(a->words, b->words, sizeof(length_t) * a->length) == 0;
+}
+
+hash_t ast_type_flat_hash(const ast_type_flat_t *flat){
+    hash_t hash = 0;
+
+    for(length_t i = 0; i != flat->length; i++){
+        hash = hash_combine(hash, flat->words[i]);
+    }
+    return hash;
+}
+
+void ast_type_flat_free(ast_type_flat_t *flat){
+    free(flat->words);
+}
@@ -84,7 +84,8 @@ static bool ast_elem_polymorph_prereq_identical(ast_elem_t *raw_a, ast_elem_t *r
     ast_elem_polymorph_prereq_t *b = (ast_elem_polymorph_prereq_t*) raw_b;
 
     if(a->allow_auto_conversion != b->allow_auto_conversion)           return false;
-    if(!streq(a->similarity_prerequisite, b->similarity_prerequisite)) return false;
+    if((a->similarity_prerequisite == NULL) != (b->similarity_prerequisite == NULL)) return false;
+    if(a->similarity_prerequisite && !streq(a->similarity_prerequisite, b->similarity_prerequisite)) return false;
     if(!ast_types_identical(&a->extends, &b->extends))                 return false;
 
     return streq(a->name, b->name);
@@ -0,0 +1,111 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/TYPE/ast_type_flat.h"
+#include "AST/TYPE/ast_type_table.h"
+#include "AST/ast_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+#define AST_TYPE_TABLE_INITIAL_CAPACITY 256
+
+void ast_type_table_init(ast_type_table_t *table, arena_t *arena){
+    table->entries = NULL;
+    table->capacity = 0;
+    table->count = 0;
+    table->scratch = (ast_type_flat_t){0};
+    table->arena = arena;
+}
+
+void ast_type_table_free(ast_type_table_t *table){
+    for(length_t i = 0; i != table->capacity; i++){
+        ast_type_table_entry_t *entry = table->entries[i];
+        if(entry) ast_type_free(&entry->type);
+    }
+
+    free(table->entries);
+    ast_type_flat_free(&table->scratch);
+}
+
+static void ast_type_table_grow(ast_type_table_t *table){
+    length_t new_capacity = table->capacity ? table->capacity * 2 : AST_TYPE_TABLE_INITIAL_CAPACITY;
+    ast_type_table_entry_t **new_entries = calloc(new_capacity, sizeof(ast_type_table_entry_t*));
+
+    // NOTE: Capacity is always a power of two
+    for(length_t i = 0; i != table->capacity; i++){
+        ast_type_table_entry_t *entry = table->entries[i];
+        if(entry == NULL) continue;
+
+        length_t slot = entry->hash & (new_capacity - 1);
+        while(new_entries[slot]) slot = (slot + 1) & (new_capacity - 1);
+        new_entries[slot] = entry;
+    }
+
+    free(table->entries);
+    table->entries = new_entries;
+    table->capacity = new_capacity;
+}
+
+ast_type_table_entry_t *ast_type_table_intern(ast_type_table_t *table, const ast_type_t *type){
+    if(!ast_type_flatten_into(type, &table->scratch)) return NULL;
+
+    // Keep load factor under 3/4
+    if((table->count + 1) * 4 > table->capacity * 3){
+        ast_type_table_grow(table);
+    }
+
+    hash_t hash = ast_type_flat_hash(&table->scratch);
+    length_t slot = hash & (table->capacity - 1);
+
+    for(ast_type_table_entry_t *entry; (entry = table->entries[slot]); slot = (slot + 1) & (table->capacity - 1)){
+        if(entry->hash == hash && ast_type_flats_identical(&entry->flat, &table->scratch)){
+            return entry;
+        }
+    }
+
+    ast_type_table_entry_t *entry = arena_alloc(table->arena, sizeof(ast_type_table_entry_t));
+
+    entry->flat = (ast_type_flat_t){
+        .words = arena_memclone(table->arena, table->scratch.words, sizeof(length_t) * table->scratch.length),
+        .length = table->scratch.length,
+        .capacity = table->scratch.length,
+    };
+
+    entry->hash = hash;
+    entry->type = ast_type_unflatten(&entry->flat, NULL_SOURCE);
+
+    table->entries[slot] = entry;
+    table->count++;
+    return entry;
+}
+
+bool ast_type_table_canonicalize(ast_type_table_t *table, ast_type_t *inout_type){
+    if(inout_type->elements_length == 0) return false;
+
+    ast_type_table_entry_t *entry = ast_type_table_intern(table, inout_type);
+    if(entry == NULL) return false;
+
+    source_t source = inout_type->source;
+    ast_type_free(inout_type);
+
+    *inout_type = (ast_type_t){
+        .elements = entry->type.elements,
+        .elements_length = entry->type.elements_length,
+        .source = source,
+    };
+    return true;
+}
+
+bool ast_type_table_canonicalize_all(ast_type_table_t *table, ast_type_t *types, length_t length){
+    // Make sure every type has a canonical instance before replacing any of them
+    for(length_t i = 0; i != length; i++){
+        if(types[i].elements_length != 0 && ast_type_table_intern(table, &types[i]) == NULL) return false;
+    }
+
+    for(length_t i = 0; i != length; i++){
+        ast_type_table_canonicalize(table, &types[i]);
+    }
+    return true;
+}
@@ -60,6 +60,17 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
     ast->poly_composites = NULL;
     ast->poly_composites_length = 0;
     ast->poly_composites_capacity = 0;
+    name_index_init(&ast->funcs_index);
+    name_index_init(&ast->composites_index);
+    name_index_init(&ast->poly_composites_index);
+    name_index_init(&ast->meta_definitions_index);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    ast->linked_composites_length = 0;
+    ast->linked_aliases_length = 0;
+    ast->linked_enums_length = 0;
+    ast->linked_globals_length = 0;
+    #endif
 
     // Add relevant standard meta definitions
 
@@ -168,6 +179,15 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
 }
 
 void ast_free(ast_t *ast){
+    #ifdef ADEPT_INSIGHT_BUILD
+    ast_free_enums(&ast->enums[ast->linked_enums_length], ast->enums_length - ast->linked_enums_length);
+    ast_free_functions(ast->funcs, ast->funcs_length);
+    ast_free_function_aliases(ast->func_aliases, ast->func_aliases_length);
+    ast_free_composites(&ast->composites[ast->linked_composites_length], ast->composites_length - ast->linked_composites_length);
+    ast_free_globals(&ast->globals[ast->linked_globals_length], ast->globals_length - ast->linked_globals_length);
+    ast_named_expression_list_free(&ast->named_expressions);
+    ast_free_aliases(&ast->aliases[ast->linked_aliases_length], ast->aliases_length - ast->linked_aliases_length);
+    #else
     ast_free_enums(ast->enums, ast->enums_length);
     ast_free_functions(ast->funcs, ast->funcs_length);
     ast_free_function_aliases(ast->func_aliases, ast->func_aliases_length);
@@ -175,6 +195,7 @@ void ast_free(ast_t *ast){
     ast_free_globals(ast->globals, ast->globals_length);
     ast_named_expression_list_free(&ast->named_expressions);
     ast_free_aliases(ast->aliases, ast->aliases_length);
+    #endif
 
     for(length_t i = 0; i != ast->libraries_length; i++){
         free(ast->libraries[i]);
@@ -210,6 +231,11 @@ void ast_free(ast_t *ast){
     }
 
     free(ast->poly_composites);
+
+    name_index_free(&ast->funcs_index);
+    name_index_free(&ast->composites_index);
+    name_index_free(&ast->poly_composites_index);
+    name_index_free(&ast->meta_definitions_index);
 }
 
 void ast_free_functions(ast_func_t *functions, length_t functions_length){
@@ -221,7 +247,12 @@ void ast_free_functions(ast_func_t *functions, length_t functions_length){
             free_strings(func->arg_names, func->arity);
         }
 
+        #ifdef ADEPT_INSIGHT_BUILD
+        if(!func->is_signature_shared) ast_types_free(func->arg_types, func->arity);
+        #else
         ast_types_free(func->arg_types, func->arity);
+        #endif
+
         free(func->arg_types);
         free(func->arg_sources);
         free(func->arg_flows);
@@ -231,7 +262,13 @@ void ast_free_functions(ast_func_t *functions, length_t functions_length){
         
         free(func->variadic_arg_name);
         ast_expr_list_free(&func->statements);
+
+        #ifdef ADEPT_INSIGHT_BUILD
+        if(!func->is_signature_shared) ast_type_free(&func->return_type);
+        #else
         ast_type_free(&func->return_type);
+        #endif
+
         free(func->export_as);
     }
 }
@@ -259,7 +296,12 @@ void ast_free_aliases(ast_alias_t *aliases, length_t aliases_length){
         ast_alias_t *alias = &aliases[i];
         free(alias->name);
         free_strings(alias->generics, alias->generics_length);
+
+        #ifdef ADEPT_INSIGHT_BUILD
+        if(!alias->is_type_shared) ast_type_free(&alias->type);
+        #else
         ast_type_free(&alias->type);
+        #endif
     }
 }
 
@@ -391,6 +433,10 @@ void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_
 
     #if ADEPT_INSIGHT_BUILD
     func->end_source = options->source;
+    func->body_token_index = 0;
+    func->composite_association = (length_t) -1;
+    func->composite_association_is_polymorphic = false;
+    func->is_signature_shared = false;
     #endif
 
     if(options->is_entry)                 func->traits |= AST_FUNC_MAIN;
@@ -438,13 +484,33 @@ void ast_enum_init(ast_enum_t *enum_definition,  weak_cstr_t name, weak_cstr_t *
 }
 
 ast_composite_t *ast_composite_find_exact(ast_t *ast, const char *name){
-    // TODO: CLEANUP: SPEED: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->composites_length; i++){
-        if(streq(ast->composites[i].name, name)){
-            return &ast->composites[i];
-        }
+    length_t index = name_index_find(&ast->composites_index, name);
+    return index != NAME_INDEX_NONE ? &ast->composites[index] : NULL;
+}
+
+func_id_t ast_find_func(ast_t *ast, const char *name){
+    // Catch up on functions created since the last lookup
+    for(length_t i = ast->funcs_index.length; i != ast->funcs_length; i++){
+        name_index_add(&ast->funcs_index, ast->funcs[i].name);
     }
-    return NULL;
+
+    length_t index = name_index_find(&ast->funcs_index, name);
+    return index != NAME_INDEX_NONE ? (func_id_t) index : INVALID_FUNC_ID;
+}
+
+func_id_t ast_find_next_func(ast_t *ast, func_id_t func_id){
+    length_t index = name_index_next(&ast->funcs_index, func_id);
+    return index != NAME_INDEX_NONE ? (func_id_t) index : INVALID_FUNC_ID;
+}
+
+meta_definition_t *ast_find_meta_definition(ast_t *ast, const char *name){
+    // Catch up on meta definitions added since the last lookup
+    for(length_t i = ast->meta_definitions_index.length; i != ast->meta_definitions_length; i++){
+        name_index_add(&ast->meta_definitions_index, ast->meta_definitions[i].name);
+    }
+
+    length_t index = name_index_find(&ast->meta_definitions_index, name);
+    return index != NAME_INDEX_NONE ? &ast->meta_definitions[index] : NULL;
 }
 
 successful_t ast_composite_find_exact_field(ast_composite_t *composite, const char *name, ast_layout_endpoint_t *out_endpoint, ast_layout_endpoint_path_t *out_path){
@@ -458,10 +524,11 @@ ast_poly_composite_t *ast_poly_composite_find_exact_from_elem(ast_t *ast, ast_el
 }
 
 ast_poly_composite_t *ast_poly_composite_find_exact(ast_t *ast, const char *name, length_t num_generics){
-    // TODO: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->poly_composites_length; i++){
-        ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
-        if(streq(poly_composite->name, name) && poly_composite->generics_length == num_generics){
+    length_t index = name_index_find(&ast->poly_composites_index, name);
+
+    for(; index != NAME_INDEX_NONE; index = name_index_next(&ast->poly_composites_index, index)){
+        ast_poly_composite_t *poly_composite = &ast->poly_composites[index];
+        if(poly_composite->generics_length == num_generics){
             return poly_composite;
         }
     }
@@ -652,6 +719,7 @@ ast_composite_t *ast_add_composite(
 ){
     expand((void**) &ast->composites, sizeof(ast_composite_t), ast->composites_length, &ast->composites_capacity, 1, 4);
 
+    name_index_add(&ast->composites_index, name);
     ast_composite_t *composite = &ast->composites[ast->composites_length++];
 
     *composite = (ast_composite_t){
@@ -679,6 +747,7 @@ ast_poly_composite_t *ast_add_poly_composite(
 ){
     expand((void**) &ast->poly_composites, sizeof(ast_poly_composite_t), ast->poly_composites_length, &ast->poly_composites_capacity, 1, 4);
 
+    name_index_add(&ast->poly_composites_index, name);
     ast_poly_composite_t *poly_composite = &ast->poly_composites[ast->poly_composites_length++];
 
     *poly_composite = (ast_poly_composite_t){
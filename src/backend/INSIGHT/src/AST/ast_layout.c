@@ -12,11 +12,15 @@
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/name_index.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
+// Field maps with fewer arrows than this are searched linearly
+#define AST_FIELD_MAP_INDEX_THRESHOLD 16
+
 void ast_layout_init(ast_layout_t *layout, ast_layout_kind_t kind, ast_field_map_t field_map, ast_layout_skeleton_t skeleton, trait_t traits){
     layout->kind = kind;
     layout->field_map = field_map;
@@ -527,6 +531,7 @@ void ast_field_map_init(ast_field_map_t *field_map){
     field_map->arrows_length = 0;
     field_map->arrows_capacity = 0;
     field_map->is_simple = true;
+    name_index_init(&field_map->index);
 }
 
 void ast_field_map_free(ast_field_map_t *field_map){
@@ -534,6 +539,7 @@ void ast_field_map_free(ast_field_map_t *field_map){
         free(field_map->arrows[i].name);
     }
     free(field_map->arrows);
+    name_index_free(&field_map->index);
 }
 
 ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
@@ -542,6 +548,7 @@ ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
     clone.arrows_length = field_map->arrows_length;
     clone.arrows_capacity = field_map->arrows_length; // (on purpose)
     clone.is_simple = field_map->is_simple;
+    name_index_init(&clone.index);
 
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *clone_arrow = &clone.arrows[i];
@@ -590,6 +597,19 @@ void ast_field_map_add(ast_field_map_t *field_map, strong_cstr_t name, ast_layou
 }
 
 successful_t ast_field_map_find(ast_field_map_t *field_map, const char *name, ast_layout_endpoint_t *out_endpoint){
+    if(field_map->arrows_length >= AST_FIELD_MAP_INDEX_THRESHOLD){
+        // Catch up on arrows added since the last lookup
+        for(length_t i = field_map->index.length; i != field_map->arrows_length; i++){
+            name_index_add(&field_map->index, field_map->arrows[i].name);
+        }
+
+        length_t i = name_index_find(&field_map->index, name);
+        if(i == NAME_INDEX_NONE) return false;
+
+        *out_endpoint = field_map->arrows[i].endpoint;
+        return true;
+    }
+
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *arrow = &field_map->arrows[i];
 
@@ -0,0 +1,437 @@
+
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_named_expression.h"
+#include "AST/ast_shift.h"
+#include "AST/ast_type.h"
+#include "UTIL/ground.h"
+
+void ast_shift_source(const ast_shift_t *shift, source_t *source){
+    if(source->object_index == shift->object_index && source->index > shift->old_end){
+        source->index = source->index - shift->old_end + shift->new_end;
+    }
+}
+
+static void ast_shift_skeleton(const ast_shift_t *shift, ast_layout_skeleton_t *skeleton){
+    for(length_t i = 0; i != skeleton->bones_length; i++){
+        ast_layout_bone_t *bone = &skeleton->bones[i];
+
+        if(bone->kind == AST_LAYOUT_BONE_KIND_TYPE){
+            ast_shift_type(shift, &bone->type);
+        } else {
+            ast_shift_skeleton(shift, &bone->children);
+        }
+    }
+}
+
+void ast_shift_layout(const ast_shift_t *shift, ast_layout_t *layout){
+    ast_shift_skeleton(shift, &layout->skeleton);
+}
+
+static void ast_shift_elem(const ast_shift_t *shift, ast_elem_t *elem){
+    ast_shift_source(shift, &elem->source);
+
+    switch(elem->id){
+    case AST_ELEM_VAR_FIXED_ARRAY:
+        ast_shift_expr(shift, ((ast_elem_var_fixed_array_t*) elem)->length);
+        break;
+    case AST_ELEM_FUNC: {
+            ast_elem_func_t *func_elem = (ast_elem_func_t*) elem;
+
+            // Borrowed signatures are moved by their owner
+            if(func_elem->ownership){
+                ast_shift_types(shift, func_elem->arg_types, func_elem->arity);
+                ast_shift_type(shift, func_elem->return_type);
+            }
+        }
+        break;
+    case AST_ELEM_POLYMORPH_PREREQ:
+        ast_shift_type(shift, &((ast_elem_polymorph_prereq_t*) elem)->extends);
+        break;
+    case AST_ELEM_GENERIC_BASE: {
+            ast_elem_generic_base_t *generic_base_elem = (ast_elem_generic_base_t*) elem;
+            ast_shift_types(shift, generic_base_elem->generics, generic_base_elem->generics_length);
+        }
+        break;
+    case AST_ELEM_LAYOUT:
+        ast_shift_layout(shift, &((ast_elem_layout_t*) elem)->layout);
+        break;
+    }
+}
+
+void ast_shift_type(const ast_shift_t *shift, ast_type_t *type){
+    ast_shift_source(shift, &type->source);
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        ast_shift_elem(shift, type->elements[i]);
+    }
+}
+
+void ast_shift_types(const ast_shift_t *shift, ast_type_t *types, length_t length){
+    for(length_t i = 0; i != length; i++){
+        ast_shift_type(shift, &types[i]);
+    }
+}
+
+static void ast_shift_outer_types(const ast_shift_t *shift, ast_type_t *types, length_t length){
+    // Only moves the outer sources of types whose elements are shared
+    for(length_t i = 0; i != length; i++){
+        ast_shift_source(shift, &types[i].source);
+    }
+}
+
+void ast_shift_exprs(const ast_shift_t *shift, ast_expr_t **exprs, length_t length){
+    for(length_t i = 0; i != length; i++){
+        ast_shift_expr(shift, exprs[i]);
+    }
+}
+
+void ast_shift_expr_list(const ast_shift_t *shift, ast_expr_list_t *list){
+    ast_shift_exprs(shift, list->statements, list->length);
+}
+
+static void ast_shift_call(const ast_shift_t *shift, ast_expr_call_t *expr){
+    ast_shift_exprs(shift, expr->args, expr->arity);
+
+    if(expr->gives.elements_length != 0){
+        ast_shift_type(shift, &expr->gives);
+    }
+}
+
+static void ast_shift_call_method(const ast_shift_t *shift, ast_expr_call_method_t *expr){
+    ast_shift_expr(shift, expr->value);
+    ast_shift_exprs(shift, expr->args, expr->arity);
+
+    if(expr->gives.elements_length != 0){
+        ast_shift_type(shift, &expr->gives);
+    }
+}
+
+static void ast_shift_func_addr(const ast_shift_t *shift, ast_expr_func_addr_t *expr){
+    if(expr->match_args){
+        ast_shift_types(shift, expr->match_args, expr->match_args_length);
+    }
+}
+
+static void ast_shift_new(const ast_shift_t *shift, ast_expr_new_t *expr){
+    ast_shift_type(shift, &expr->type);
+    ast_shift_expr(shift, expr->amount);
+
+    if(expr->inputs.has){
+        ast_shift_expr_list(shift, &expr->inputs.value);
+    }
+}
+
+static void ast_shift_declare(const ast_shift_t *shift, ast_expr_declare_t *expr){
+    ast_shift_type(shift, &expr->type);
+    ast_shift_expr(shift, expr->value);
+
+    if(expr->inputs.has){
+        ast_shift_expr_list(shift, &expr->inputs.value);
+    }
+}
+
+static void ast_shift_each_in(const ast_shift_t *shift, ast_expr_each_in_t *expr){
+    if(expr->it_type){
+        ast_shift_type(shift, expr->it_type);
+    }
+
+    ast_shift_expr(shift, expr->low_array);
+    ast_shift_expr(shift, expr->length);
+    ast_shift_expr(shift, expr->list);
+    ast_shift_expr_list(shift, &expr->statements);
+}
+
+static void ast_shift_switch(const ast_shift_t *shift, ast_expr_switch_t *expr){
+    ast_shift_expr(shift, expr->value);
+
+    for(length_t i = 0; i != expr->cases.length; i++){
+        ast_case_t *single_case = &expr->cases.cases[i];
+
+        ast_shift_source(shift, &single_case->source);
+        ast_shift_expr(shift, single_case->condition);
+        ast_shift_expr_list(shift, &single_case->statements);
+    }
+
+    ast_shift_expr_list(shift, &expr->or_default);
+}
+
+static void ast_shift_for(const ast_shift_t *shift, ast_expr_for_t *expr){
+    ast_shift_expr_list(shift, &expr->before);
+    ast_shift_expr_list(shift, &expr->after);
+    ast_shift_expr(shift, expr->condition);
+    ast_shift_expr_list(shift, &expr->statements);
+}
+
+void ast_shift_expr(const ast_shift_t *shift, ast_expr_t *expr){
+    if(expr == NULL) return;
+
+    ast_shift_source(shift, &expr->source);
+
+    switch(expr->id){
+    case EXPR_ADD:
+    case EXPR_SUBTRACT:
+    case EXPR_MULTIPLY:
+    case EXPR_DIVIDE:
+    case EXPR_MODULUS:
+    case EXPR_EQUALS:
+    case EXPR_NOTEQUALS:
+    case EXPR_GREATER:
+    case EXPR_LESSER:
+    case EXPR_GREATEREQ:
+    case EXPR_LESSEREQ:
+    case EXPR_AND:
+    case EXPR_OR:
+    case EXPR_BIT_AND:
+    case EXPR_BIT_OR:
+    case EXPR_BIT_XOR:
+    case EXPR_BIT_LSHIFT:
+    case EXPR_BIT_RSHIFT:
+    case EXPR_BIT_LGC_LSHIFT:
+    case EXPR_BIT_LGC_RSHIFT:
+        ast_shift_expr(shift, ((ast_expr_math_t*) expr)->a);
+        ast_shift_expr(shift, ((ast_expr_math_t*) expr)->b);
+        break;
+    case EXPR_CALL:
+        ast_shift_call(shift, (ast_expr_call_t*) expr);
+        break;
+    case EXPR_SUPER:
+        ast_shift_exprs(shift, ((ast_expr_super_t*) expr)->args, ((ast_expr_super_t*) expr)->arity);
+        break;
+    case EXPR_MEMBER:
+        ast_shift_expr(shift, ((ast_expr_member_t*) expr)->value);
+        break;
+    case EXPR_ARRAY_ACCESS:
+    case EXPR_AT:
+        ast_shift_expr(shift, ((ast_expr_array_access_t*) expr)->value);
+        ast_shift_expr(shift, ((ast_expr_array_access_t*) expr)->index);
+        break;
+    case EXPR_CAST:
+        ast_shift_type(shift, &((ast_expr_cast_t*) expr)->to);
+        ast_shift_expr(shift, ((ast_expr_cast_t*) expr)->from);
+        break;
+    case EXPR_SIZEOF:
+    case EXPR_ALIGNOF:
+    case EXPR_TYPENAMEOF:
+    case EXPR_TYPEINFO:
+        ast_shift_type(shift, &((ast_expr_unary_type_t*) expr)->type);
+        break;
+    case EXPR_PHANTOM:
+        ast_shift_type(shift, &((ast_expr_phantom_t*) expr)->type);
+        break;
+    case EXPR_CALL_METHOD:
+        ast_shift_call_method(shift, (ast_expr_call_method_t*) expr);
+        break;
+    case EXPR_VA_ARG:
+        ast_shift_expr(shift, ((ast_expr_va_arg_t*) expr)->va_list);
+        ast_shift_type(shift, &((ast_expr_va_arg_t*) expr)->arg_type);
+        break;
+    case EXPR_INITLIST:
+        ast_shift_exprs(shift, ((ast_expr_initlist_t*) expr)->elements, ((ast_expr_initlist_t*) expr)->length);
+        break;
+    case EXPR_LLVM_ASM:
+        ast_shift_exprs(shift, ((ast_expr_llvm_asm_t*) expr)->args, ((ast_expr_llvm_asm_t*) expr)->arity);
+        break;
+    case EXPR_SIZEOF_VALUE:
+    case EXPR_ADDRESS:
+    case EXPR_DEREFERENCE:
+    case EXPR_BIT_COMPLEMENT:
+    case EXPR_NOT:
+    case EXPR_NEGATE:
+    case EXPR_DELETE:
+    case EXPR_PREINCREMENT:
+    case EXPR_PREDECREMENT:
+    case EXPR_POSTINCREMENT:
+    case EXPR_POSTDECREMENT:
+    case EXPR_TOGGLE:
+    case EXPR_VA_START:
+    case EXPR_VA_END:
+        ast_shift_expr(shift, ((ast_expr_unary_t*) expr)->value);
+        break;
+    case EXPR_FUNC_ADDR:
+        ast_shift_func_addr(shift, (ast_expr_func_addr_t*) expr);
+        break;
+    case EXPR_NEW:
+        ast_shift_new(shift, (ast_expr_new_t*) expr);
+        break;
+    case EXPR_STATIC_ARRAY:
+    case EXPR_STATIC_STRUCT:
+        ast_shift_type(shift, &((ast_expr_static_data_t*) expr)->type);
+        ast_shift_exprs(shift, ((ast_expr_static_data_t*) expr)->values, ((ast_expr_static_data_t*) expr)->length);
+        break;
+    case EXPR_TERNARY:
+        ast_shift_expr(shift, ((ast_expr_ternary_t*) expr)->condition);
+        ast_shift_expr(shift, ((ast_expr_ternary_t*) expr)->if_true);
+        ast_shift_expr(shift, ((ast_expr_ternary_t*) expr)->if_false);
+        break;
+    case EXPR_RETURN:
+        ast_shift_expr(shift, ((ast_expr_return_t*) expr)->value);
+        ast_shift_expr_list(shift, &((ast_expr_return_t*) expr)->last_minute);
+        break;
+    case EXPR_DECLARE:
+    case EXPR_ILDECLARE:
+    case EXPR_DECLAREUNDEF:
+    case EXPR_ILDECLAREUNDEF:
+        ast_shift_declare(shift, (ast_expr_declare_t*) expr);
+        break;
+    case EXPR_ASSIGN:
+    case EXPR_ADD_ASSIGN:
+    case EXPR_SUBTRACT_ASSIGN:
+    case EXPR_MULTIPLY_ASSIGN:
+    case EXPR_DIVIDE_ASSIGN:
+    case EXPR_MODULUS_ASSIGN:
+    case EXPR_AND_ASSIGN:
+    case EXPR_OR_ASSIGN:
+    case EXPR_XOR_ASSIGN:
+    case EXPR_LSHIFT_ASSIGN:
+    case EXPR_RSHIFT_ASSIGN:
+    case EXPR_LGC_LSHIFT_ASSIGN:
+    case EXPR_LGC_RSHIFT_ASSIGN:
+        ast_shift_expr(shift, ((ast_expr_assign_t*) expr)->destination);
+        ast_shift_expr(shift, ((ast_expr_assign_t*) expr)->value);
+        break;
+    case EXPR_IF:
+    case EXPR_UNLESS:
+    case EXPR_WHILE:
+    case EXPR_UNTIL:
+    case EXPR_WHILECONTINUE:
+    case EXPR_UNTILBREAK:
+        ast_shift_expr(shift, ((ast_expr_conditional_t*) expr)->value);
+        ast_shift_expr_list(shift, &((ast_expr_conditional_t*) expr)->statements);
+        break;
+    case EXPR_IFELSE:
+    case EXPR_UNLESSELSE:
+        ast_shift_expr(shift, ((ast_expr_conditional_else_t*) expr)->value);
+        ast_shift_expr_list(shift, &((ast_expr_conditional_else_t*) expr)->statements);
+        ast_shift_expr_list(shift, &((ast_expr_conditional_else_t*) expr)->else_statements);
+        break;
+    case EXPR_EACH_IN:
+        ast_shift_each_in(shift, (ast_expr_each_in_t*) expr);
+        break;
+    case EXPR_REPEAT:
+        ast_shift_expr(shift, ((ast_expr_repeat_t*) expr)->limit);
+        ast_shift_expr_list(shift, &((ast_expr_repeat_t*) expr)->statements);
+        break;
+    case EXPR_SWITCH:
+        ast_shift_switch(shift, (ast_expr_switch_t*) expr);
+        break;
+    case EXPR_VA_COPY:
+        ast_shift_expr(shift, ((ast_expr_va_copy_t*) expr)->dest_value);
+        ast_shift_expr(shift, ((ast_expr_va_copy_t*) expr)->src_value);
+        break;
+    case EXPR_FOR:
+        ast_shift_for(shift, (ast_expr_for_t*) expr);
+        break;
+    case EXPR_DECLARE_NAMED_EXPRESSION:
+        ast_shift_source(shift, &((ast_expr_declare_named_expression_t*) expr)->named_expression.source);
+        ast_shift_expr(shift, ((ast_expr_declare_named_expression_t*) expr)->named_expression.expression);
+        break;
+    case EXPR_CONDITIONLESS_BLOCK:
+        ast_shift_expr_list(shift, &((ast_expr_conditionless_block_t*) expr)->statements);
+        break;
+    case EXPR_ASSERT:
+        ast_shift_expr(shift, ((ast_expr_assert_t*) expr)->assertion);
+        ast_shift_expr(shift, ((ast_expr_assert_t*) expr)->message);
+        break;
+    case EXPR_BREAK_TO:
+    case EXPR_CONTINUE_TO:
+        ast_shift_source(shift, &((ast_expr_break_to_t*) expr)->label_source);
+        break;
+    }
+}
+
+static void ast_shift_func(const ast_shift_t *shift, ast_func_t *func){
+    ast_shift_source(shift, &func->source);
+    ast_shift_source(shift, &func->end_source);
+    ast_shift_source(shift, &func->variadic_source);
+
+    if(func->arg_sources){
+        for(length_t i = 0; i != func->arity; i++){
+            ast_shift_source(shift, &func->arg_sources[i]);
+        }
+    }
+
+    if(func->arg_defaults){
+        ast_shift_exprs(shift, func->arg_defaults, func->arity);
+    }
+
+    if(func->is_signature_shared){
+        ast_shift_outer_types(shift, func->arg_types, func->arity);
+        ast_shift_outer_types(shift, &func->return_type, 1);
+    } else {
+        ast_shift_types(shift, func->arg_types, func->arity);
+        ast_shift_type(shift, &func->return_type);
+    }
+
+    ast_shift_expr_list(shift, &func->statements);
+}
+
+static void ast_shift_composite(const ast_shift_t *shift, ast_composite_t *composite){
+    ast_shift_source(shift, &composite->source);
+    ast_shift_layout(shift, &composite->layout);
+    ast_shift_type(shift, &composite->parent);
+}
+
+void ast_shift_all(const ast_shift_t *shift, ast_t *ast){
+    // NOTE: Declarations linked from the prelude are shared, and never belong to the edited object
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_shift_func(shift, &ast->funcs[i]);
+    }
+
+    for(length_t i = 0; i != ast->func_aliases_length; i++){
+        ast_func_alias_t *falias = &ast->func_aliases[i];
+
+        ast_shift_source(shift, &falias->source);
+        ast_shift_types(shift, falias->arg_types, falias->arity);
+    }
+
+    for(length_t i = ast->linked_composites_length; i != ast->composites_length; i++){
+        ast_shift_composite(shift, &ast->composites[i]);
+    }
+
+    for(length_t i = 0; i != ast->poly_composites_length; i++){
+        ast_shift_composite(shift, (ast_composite_t*) &ast->poly_composites[i]);
+    }
+
+    for(length_t i = ast->linked_aliases_length; i != ast->aliases_length; i++){
+        ast_alias_t *alias = &ast->aliases[i];
+
+        ast_shift_source(shift, &alias->source);
+
+        if(alias->is_type_shared){
+            ast_shift_outer_types(shift, &alias->type, 1);
+        } else {
+            ast_shift_type(shift, &alias->type);
+        }
+    }
+
+    for(length_t i = ast->linked_globals_length; i != ast->globals_length; i++){
+        ast_global_t *global = &ast->globals[i];
+
+        ast_shift_source(shift, &global->source);
+        ast_shift_type(shift, &global->type);
+        ast_shift_expr(shift, global->initial);
+    }
+
+    for(length_t i = ast->linked_enums_length; i != ast->enums_length; i++){
+        ast_shift_source(shift, &ast->enums[i].source);
+    }
+
+    for(length_t i = 0; i != ast->named_expressions.length; i++){
+        ast_named_expression_t *named_expression = &ast->named_expressions.expressions[i];
+
+        ast_shift_source(shift, &named_expression->source);
+        ast_shift_expr(shift, named_expression->expression);
+    }
+
+    if(ast->common.ast_variadic_array){
+        ast_shift_source(shift, &ast->common.ast_variadic_source);
+        ast_shift_type(shift, ast->common.ast_variadic_array);
+    }
+
+    if(ast->common.ast_initializer_list){
+        ast_shift_source(shift, &ast->common.ast_initializer_list_source);
+        ast_shift_type(shift, ast->common.ast_initializer_list);
+    }
+}
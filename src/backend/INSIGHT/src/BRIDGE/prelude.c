@@ -0,0 +1,72 @@
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/ast.h"
+#include "BRIDGE/any.h"
+#include "BRIDGE/prelude.h"
+#include "DRVR/compiler.h"
+#include "UTIL/ground.h"
+#include "UTIL/name_index.h"
+#include "UTIL/util.h"
+
+static ast_t prelude;
+static bool prelude_constructed = false;
+
+static bool prelude_supports(compiler_t *compiler){
+    // The shape of 'va_list' depends on the target, and unusual shapes are warned about,
+    // so only the usual shapes for the current target can be shared
+    return compiler->cross_compile_for == CROSS_COMPILE_NONE
+        && (sizeof(va_list) <= 8 || sizeof(va_list) == 24);
+}
+
+static void prelude_construct(compiler_t *compiler){
+    ast_init(&prelude, CROSS_COMPILE_NONE);
+    any_inject_ast(&prelude);
+    va_args_inject_ast(compiler, &prelude);
+
+    prelude_constructed = true;
+}
+
+void prelude_link_ast(compiler_t *compiler, ast_t *ast){
+    if(!prelude_supports(compiler)){
+        any_inject_ast(ast);
+        va_args_inject_ast(compiler, ast);
+        return;
+    }
+
+    if(!prelude_constructed) prelude_construct(compiler);
+
+    // NOTE: Linked declarations always come first, since nothing has been parsed yet
+    ast->linked_composites_length = prelude.composites_length;
+    ast->linked_aliases_length = prelude.aliases_length;
+    ast->linked_enums_length = prelude.enums_length;
+    ast->linked_globals_length = prelude.globals_length;
+
+    expand((void**) &ast->composites, sizeof(ast_composite_t), ast->composites_length, &ast->composites_capacity, prelude.composites_length, 4);
+
+    for(length_t i = 0; i != prelude.composites_length; i++){
+        ast_composite_t *composite = &ast->composites[ast->composites_length++];
+        *composite = prelude.composites[i];
+        name_index_add(&ast->composites_index, composite->name);
+    }
+
+    expand((void**) &ast->aliases, sizeof(ast_alias_t), ast->aliases_length, &ast->aliases_capacity, prelude.aliases_length, 8);
+
+    for(length_t i = 0; i != prelude.aliases_length; i++){
+        ast->aliases[ast->aliases_length++] = prelude.aliases[i];
+    }
+
+    expand((void**) &ast->enums, sizeof(ast_enum_t), ast->enums_length, &ast->enums_capacity, prelude.enums_length, 4);
+
+    for(length_t i = 0; i != prelude.enums_length; i++){
+        ast->enums[ast->enums_length++] = prelude.enums[i];
+    }
+
+    expand((void**) &ast->globals, sizeof(ast_global_t), ast->globals_length, &ast->globals_capacity, prelude.globals_length, 8);
+
+    for(length_t i = 0; i != prelude.globals_length; i++){
+        ast->globals[ast->globals_length++] = prelude.globals[i];
+    }
+}
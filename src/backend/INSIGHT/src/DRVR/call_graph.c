@@ -0,0 +1,881 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/call_graph.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+// ---------------- call_graph_site_t ----------------
+// A call within the body of a function,
+// relative to the beginning of the function so it survives the function moving
+typedef struct {
+    length_t callee;
+    length_t offset;
+    length_t stride;
+} call_graph_site_t;
+
+// ---------------- call_graph_func_t ----------------
+// A function of a file, and the calls within its body sorted by callee and then by offset
+typedef struct {
+    length_t name;
+    hash_t hash;
+    length_t begin;
+    length_t length;
+    length_t name_offset;
+    bool has_sites;
+    call_graph_site_t *sites;
+    length_t sites_length;
+} call_graph_func_t;
+
+// ---------------- call_graph_file_t ----------------
+// The functions of a file, sorted by where they begin
+typedef struct {
+    strong_cstr_t absolute;
+    text_version_t version;
+    bool is_complete;
+    length_t *line_begins;
+    length_t lines_length;
+    length_t lines_capacity;
+    call_graph_func_t *funcs;
+    length_t funcs_length;
+    length_t funcs_capacity;
+} call_graph_file_t;
+
+// ---------------- call_graph_ref_t ----------------
+// Entry of an index over every function or every call, sorted by name
+typedef struct {
+    length_t name;
+    length_t file;
+    length_t func;
+    length_t site;
+} call_graph_ref_t;
+
+// ---------------- call_graph_walk_t ----------------
+// Calls found so far while walking the body of a function
+typedef struct {
+    length_t object_index;
+    length_t begin;
+    call_graph_site_t *sites;
+    length_t sites_length;
+    length_t sites_capacity;
+} call_graph_walk_t;
+
+static strong_cstr_t *names = NULL;
+static length_t names_length = 0;
+static length_t names_capacity = 0;
+static name_index_t names_index;
+
+static call_graph_file_t *files = NULL;
+static length_t files_length = 0;
+static length_t files_capacity = 0;
+static name_index_t files_index;
+
+// Indices over the whole graph, which are rebuilt once needed after the graph changes
+static bool indices_are_stale = true;
+static call_graph_ref_t *definitions = NULL;
+static length_t definitions_length = 0;
+static length_t definitions_capacity = 0;
+static call_graph_ref_t *callers = NULL;
+static length_t callers_length = 0;
+static length_t callers_capacity = 0;
+
+static length_t call_graph_intern(weak_cstr_t name){
+    if(names == NULL) name_index_init(&names_index);
+
+    length_t found = name_index_find(&names_index, name);
+    if(found != NAME_INDEX_NONE) return found;
+
+    expand((void**) &names, sizeof(strong_cstr_t), names_length, &names_capacity, 1, 1024);
+    names[names_length] = strclone(name);
+
+    // NOTE: Names are never moved, so they can be borrowed by the index
+    name_index_add(&names_index, names[names_length]);
+    return names_length++;
+}
+
+static call_graph_file_t *call_graph_find_file(weak_cstr_t absolute){
+    if(files == NULL) return NULL;
+
+    length_t found = name_index_find(&files_index, absolute);
+    return found != NAME_INDEX_NONE ? &files[found] : NULL;
+}
+
+static call_graph_file_t *call_graph_file(weak_cstr_t absolute){
+    call_graph_file_t *file = call_graph_find_file(absolute);
+    if(file) return file;
+
+    if(files == NULL) name_index_init(&files_index);
+
+    expand((void**) &files, sizeof(call_graph_file_t), files_length, &files_capacity, 1, 64);
+
+    files[files_length] = (call_graph_file_t){
+        .absolute = strclone(absolute),
+    };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&files_index, files[files_length].absolute);
+    return &files[files_length++];
+}
+
+static void call_graph_walk_expressions(ast_expr_t **exprs, length_t length, call_graph_walk_t *walk);
+static void call_graph_walk_list(ast_expr_list_t *exprs, call_graph_walk_t *walk);
+
+static void call_graph_walk_expression(ast_expr_t *expr, call_graph_walk_t *walk){
+    if(expr == NULL) return;
+
+    maybe_null_weak_cstr_t name = NULL;
+
+    switch(expr->id){
+    case EXPR_BYTE:
+    case EXPR_UBYTE:
+    case EXPR_SHORT:
+    case EXPR_USHORT:
+    case EXPR_INT:
+    case EXPR_UINT:
+    case EXPR_LONG:
+    case EXPR_ULONG:
+    case EXPR_USIZE:
+    case EXPR_FLOAT:
+    case EXPR_DOUBLE:
+    case EXPR_BOOLEAN:
+    case EXPR_STR:
+    case EXPR_CSTR:
+    case EXPR_NULL:
+    case EXPR_GENERIC_INT:
+    case EXPR_GENERIC_FLOAT:
+        break;
+    case EXPR_ADD:
+    case EXPR_SUBTRACT:
+    case EXPR_MULTIPLY:
+    case EXPR_DIVIDE:
+    case EXPR_MODULUS:
+    case EXPR_EQUALS:
+    case EXPR_NOTEQUALS:
+    case EXPR_GREATER:
+    case EXPR_LESSER:
+    case EXPR_GREATEREQ:
+    case EXPR_LESSEREQ:
+    case EXPR_AND:
+    case EXPR_OR:
+    case EXPR_BIT_AND:
+    case EXPR_BIT_OR:
+    case EXPR_BIT_XOR:
+    case EXPR_BIT_LSHIFT:
+    case EXPR_BIT_RSHIFT:
+    case EXPR_BIT_LGC_LSHIFT:
+    case EXPR_BIT_LGC_RSHIFT:
+        call_graph_walk_expression(((ast_expr_math_t*) expr)->a, walk);
+        call_graph_walk_expression(((ast_expr_math_t*) expr)->b, walk);
+        break;
+    case EXPR_NEGATE:
+    case EXPR_ADDRESS:
+    case EXPR_DEREFERENCE:
+    case EXPR_SIZEOF_VALUE:
+    case EXPR_PREINCREMENT:
+    case EXPR_PREDECREMENT:
+    case EXPR_POSTINCREMENT:
+    case EXPR_POSTDECREMENT:
+    case EXPR_TOGGLE:
+    case EXPR_NOT:
+    case EXPR_BIT_COMPLEMENT:
+        call_graph_walk_expression(((ast_expr_unary_t*) expr)->value, walk);
+        break;
+    case EXPR_ARRAY_ACCESS:
+    case EXPR_AT:
+        call_graph_walk_expression(((ast_expr_array_access_t*) expr)->value, walk);
+        break;
+    case EXPR_SUPER:
+        call_graph_walk_expressions(((ast_expr_super_t*) expr)->args, ((ast_expr_super_t*) expr)->arity, walk);
+        break;
+    case EXPR_VARIABLE:
+        break;
+    case EXPR_MEMBER:
+        call_graph_walk_expression(((ast_expr_member_t*) expr)->value, walk);
+        break;
+    case EXPR_FUNC_ADDR:
+        break;
+    case EXPR_CAST:
+        call_graph_walk_expression(((ast_expr_cast_t*) expr)->from, walk);
+        break;
+    case EXPR_SIZEOF:
+    case EXPR_ALIGNOF:
+        break;
+    case EXPR_NEW: {
+            ast_expr_t *amount = ((ast_expr_new_t*) expr)->amount;
+            if(amount) call_graph_walk_expression(amount, walk);
+        }
+        break;
+    case EXPR_NEW_CSTRING:
+        break;
+    case EXPR_ENUM_VALUE:
+    case EXPR_GENERIC_ENUM_VALUE:
+        break;
+    case EXPR_STATIC_ARRAY:
+    case EXPR_STATIC_STRUCT: {
+            ast_expr_static_data_t *static_data = ((ast_expr_static_data_t*) expr);
+            call_graph_walk_expressions(static_data->values, static_data->length, walk);
+        }
+        break;
+    case EXPR_TYPEINFO:
+        break;
+    case EXPR_TERNARY:
+        call_graph_walk_expression(((ast_expr_ternary_t*) expr)->condition, walk);
+        call_graph_walk_expression(((ast_expr_ternary_t*) expr)->if_true, walk);
+        call_graph_walk_expression(((ast_expr_ternary_t*) expr)->if_false, walk);
+        break;
+    case EXPR_PHANTOM:
+        break;
+    case EXPR_VA_ARG:
+        call_graph_walk_expression(((ast_expr_va_arg_t*) expr)->va_list, walk);
+        break;
+    case EXPR_INITLIST: {
+            ast_expr_initlist_t *initlist = ((ast_expr_initlist_t*) expr);
+            call_graph_walk_expressions(initlist->elements, initlist->length, walk);
+        }
+        break;
+    case EXPR_POLYCOUNT:
+        break;
+    case EXPR_TYPENAMEOF:
+        break;
+    case EXPR_LLVM_ASM: {
+            ast_expr_llvm_asm_t *llvm_asm = (ast_expr_llvm_asm_t*) expr;
+            call_graph_walk_expressions(llvm_asm->args, llvm_asm->arity, walk);
+        }
+        break;
+    case EXPR_EMBED:
+        break;
+    case EXPR_DECLARE:
+    case EXPR_DECLAREUNDEF:
+    case EXPR_ILDECLARE:
+    case EXPR_ILDECLAREUNDEF: {
+            ast_expr_declare_t *declare = (ast_expr_declare_t*) expr;
+            if(declare->inputs.has) call_graph_walk_list(&declare->inputs.value, walk);
+            if(declare->value) call_graph_walk_expression(declare->value, walk);
+        }
+        break;
+    case EXPR_ASSIGN:
+    case EXPR_ADD_ASSIGN:
+    case EXPR_SUBTRACT_ASSIGN:
+    case EXPR_MULTIPLY_ASSIGN:
+    case EXPR_DIVIDE_ASSIGN:
+    case EXPR_MODULUS_ASSIGN:
+    case EXPR_AND_ASSIGN:
+    case EXPR_OR_ASSIGN:
+    case EXPR_XOR_ASSIGN:
+    case EXPR_LSHIFT_ASSIGN:
+    case EXPR_RSHIFT_ASSIGN:
+    case EXPR_LGC_LSHIFT_ASSIGN:
+    case EXPR_LGC_RSHIFT_ASSIGN: {
+            ast_expr_assign_t *assign = (ast_expr_assign_t*) expr;
+            call_graph_walk_expression(assign->destination, walk);
+            call_graph_walk_expression(assign->value, walk);
+        }
+        break;
+    case EXPR_RETURN: {
+            ast_expr_return_t *ret = (ast_expr_return_t*) expr;
+            if(ret->value) call_graph_walk_expression(ret->value, walk);
+            call_graph_walk_list(&ret->last_minute, walk);
+        }
+        break;
+    case EXPR_DELETE:
+        call_graph_walk_expression(((ast_expr_delete_t*) expr)->value, walk);
+        break;
+    case EXPR_BREAK:
+    case EXPR_CONTINUE:
+    case EXPR_FALLTHROUGH:
+    case EXPR_BREAK_TO:
+    case EXPR_CONTINUE_TO:
+        break;
+    case EXPR_VA_START: {
+            ast_expr_va_start_t *start = (ast_expr_va_start_t*) expr;
+            call_graph_walk_expression(start->value, walk);
+        }
+        break;
+    case EXPR_VA_END: {
+            ast_expr_va_end_t *end = (ast_expr_va_end_t*) expr;
+            call_graph_walk_expression(end->value, walk);
+        }
+        break;
+    case EXPR_VA_COPY: {
+            ast_expr_va_copy_t *copy = (ast_expr_va_copy_t*) expr;
+            call_graph_walk_expression(copy->src_value, walk);
+            call_graph_walk_expression(copy->dest_value, walk);
+        }
+        break;
+    case EXPR_DECLARE_NAMED_EXPRESSION: {
+            ast_expr_declare_named_expression_t *declare_named_expression = (ast_expr_declare_named_expression_t*) expr;
+            call_graph_walk_expression(declare_named_expression->named_expression.expression, walk);
+        }
+        break;
+    case EXPR_ASSERT: {
+            ast_expr_assert_t *assertion = (ast_expr_assert_t*) expr;
+            if(assertion->assertion) call_graph_walk_expression(assertion->assertion, walk);
+            if(assertion->message) call_graph_walk_expression(assertion->message, walk);
+        }
+        break;
+    case EXPR_CALL: {
+            ast_expr_call_t *call = (ast_expr_call_t*) expr;
+            name = call->name;
+            call_graph_walk_expressions(call->args, call->arity, walk);
+        }
+        break;
+    case EXPR_CALL_METHOD: {
+            ast_expr_call_method_t *call_method = (ast_expr_call_method_t*) expr;
+            name = call_method->name;
+            call_graph_walk_expressions(call_method->args, call_method->arity, walk);
+            call_graph_walk_expression(call_method->value, walk);
+        }
+        break;
+    case EXPR_IF:
+    case EXPR_UNLESS:
+    case EXPR_WHILE:
+    case EXPR_UNTIL:
+        call_graph_walk_list(&((ast_expr_if_t*) expr)->statements, walk);
+        break;
+    case EXPR_IFELSE:
+    case EXPR_UNLESSELSE:
+        call_graph_walk_list(&((ast_expr_ifelse_t*) expr)->statements, walk);
+        call_graph_walk_list(&((ast_expr_ifelse_t*) expr)->else_statements, walk);
+        break;
+    case EXPR_WHILECONTINUE:
+    case EXPR_UNTILBREAK:
+        call_graph_walk_list(&((ast_expr_whilecontinue_t*) expr)->statements, walk);
+        break;
+    case EXPR_CONDITIONLESS_BLOCK:
+        call_graph_walk_list(&((ast_expr_conditionless_block_t*) expr)->statements, walk);
+        break;
+    case EXPR_FOR: {
+            ast_expr_for_t *for_loop = (ast_expr_for_t*) expr;
+            call_graph_walk_list(&for_loop->before, walk);
+            call_graph_walk_list(&for_loop->after, walk);
+            call_graph_walk_expression(for_loop->condition, walk);
+            call_graph_walk_list(&for_loop->statements, walk);
+        }
+        break;
+    case EXPR_EACH_IN: {
+            ast_expr_each_in_t *each_in = (ast_expr_each_in_t*) expr;
+            if(each_in->length) call_graph_walk_expression(each_in->length, walk);
+            if(each_in->list) call_graph_walk_expression(each_in->list, walk);
+            if(each_in->low_array) call_graph_walk_expression(each_in->low_array, walk);
+
+            call_graph_walk_list(&each_in->statements, walk);
+        }
+        break;
+    case EXPR_REPEAT: {
+            ast_expr_repeat_t *repeat = (ast_expr_repeat_t*) expr;
+            if(repeat->limit) call_graph_walk_expression(repeat->limit, walk);
+            call_graph_walk_list(&repeat->statements, walk);
+        }
+        break;
+    case EXPR_SWITCH: {
+            ast_expr_switch_t *switch_stmt = (ast_expr_switch_t*) expr;
+
+            call_graph_walk_expression(switch_stmt->value, walk);
+            call_graph_walk_list(&switch_stmt->or_default, walk);
+
+            for(length_t i = 0; i < switch_stmt->cases.length; i++){
+                ast_case_t *switch_case = &switch_stmt->cases.cases[i];
+                call_graph_walk_expression(switch_case->condition, walk);
+                call_graph_walk_list(&switch_case->statements, walk);
+            }
+        }
+        break;
+    default:
+        die("call_graph_walk_expression() - Got unrecognized expression ID 0x%08X\n", expr->id);
+        return;
+    }
+
+    if(name && expr->source.object_index == walk->object_index && expr->source.index >= walk->begin){
+        expand((void**) &walk->sites, sizeof(call_graph_site_t), walk->sites_length, &walk->sites_capacity, 1, 16);
+
+        walk->sites[walk->sites_length++] = (call_graph_site_t){
+            .callee = call_graph_intern(name),
+            .offset = expr->source.index - walk->begin,
+            .stride = strlen(name),
+        };
+    }
+}
+
+static void call_graph_walk_expressions(ast_expr_t **exprs, length_t length, call_graph_walk_t *walk){
+    if(exprs == NULL) return;
+
+    for(length_t i = 0; i < length; i++){
+        call_graph_walk_expression(exprs[i], walk);
+    }
+}
+
+static void call_graph_walk_list(ast_expr_list_t *exprs, call_graph_walk_t *walk){
+    for(length_t i = 0; i < exprs->length; i++){
+        call_graph_walk_expression(exprs->expressions[i], walk);
+    }
+}
+
+static int call_graph_compare_sites(const void *a, const void *b){
+    const call_graph_site_t *first = a;
+    const call_graph_site_t *second = b;
+
+    if(first->callee != second->callee) return first->callee < second->callee ? -1 : 1;
+    return first->offset < second->offset ? -1 : first->offset > second->offset;
+}
+
+static int call_graph_compare_funcs_by_hash(const void *a, const void *b){
+    const call_graph_func_t *first = a;
+    const call_graph_func_t *second = b;
+    return first->hash < second->hash ? -1 : first->hash > second->hash;
+}
+
+static int call_graph_compare_funcs_by_begin(const void *a, const void *b){
+    const call_graph_func_t *first = a;
+    const call_graph_func_t *second = b;
+    return first->begin < second->begin ? -1 : first->begin > second->begin;
+}
+
+static int call_graph_compare_refs(const void *a, const void *b){
+    const call_graph_ref_t *first = a;
+    const call_graph_ref_t *second = b;
+
+    if(first->name != second->name) return first->name < second->name ? -1 : 1;
+    if(first->file != second->file) return first->file < second->file ? -1 : 1;
+    if(first->func != second->func) return first->func < second->func ? -1 : 1;
+    return first->site < second->site ? -1 : first->site > second->site;
+}
+
+static int call_graph_compare_counts(const void *a, const void *b){
+    return strcmp(((const call_graph_count_t*) a)->name, ((const call_graph_count_t*) b)->name);
+}
+
+static void call_graph_index_lines(call_graph_file_t *file, const char *buffer, length_t buffer_length){
+    file->lines_length = 0;
+
+    expand((void**) &file->line_begins, sizeof(length_t), file->lines_length, &file->lines_capacity, 1, 256);
+    file->line_begins[file->lines_length++] = 0;
+
+    const char *newline = memchr(buffer, '\n', buffer_length);
+
+    while(newline){
+        length_t next = newline + 1 - buffer;
+
+        expand((void**) &file->line_begins, sizeof(length_t), file->lines_length, &file->lines_capacity, 1, 256);
+        file->line_begins[file->lines_length++] = next;
+
+        newline = memchr(&buffer[next], '\n', buffer_length - next);
+    }
+}
+
+static call_graph_position_t call_graph_position(call_graph_file_t *file, length_t index){
+    // Find the last line that begins at or before the index
+    length_t low = 0;
+    length_t high = file->lines_length;
+
+    while(high - low > 1){
+        length_t middle = low + (high - low) / 2;
+
+        if(file->line_begins[middle] <= index){
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return (call_graph_position_t){
+        .line = low,
+        .character = index - file->line_begins[low],
+    };
+}
+
+static length_t call_graph_func_length(object_t *object, ast_func_t *func){
+    length_t begin = func->source.index;
+    source_t end_source = func->end_source;
+
+    // Functions without bodies end at the end of their line
+    if(end_source.object_index != func->source.object_index || end_source.index <= begin){
+        const char *newline = memchr(&object->buffer[begin], '\n', object->buffer_length - begin);
+        return newline ? (length_t) (newline - &object->buffer[begin]) : object->buffer_length - begin;
+    }
+
+    length_t end = end_source.index + end_source.stride;
+    return (end < object->buffer_length ? end : object->buffer_length) - begin;
+}
+
+static length_t call_graph_name_offset(const char *text, length_t length, weak_cstr_t name){
+    // Skip over the keyword that the function begins with
+    length_t i = 0;
+    while(i != length && (isalnum((unsigned char) text[i]) || text[i] == '_')) i++;
+
+    length_t name_length = strlen(name);
+
+    for(; i + name_length <= length; i++){
+        if(memcmp(&text[i], name, name_length) == 0) return i;
+    }
+
+    return 0;
+}
+
+static call_graph_func_t *call_graph_find_previous(call_graph_func_t *previous, length_t previous_length, call_graph_func_t *func, bool is_lazy){
+    // Find the first previous function with the same hash
+    length_t low = 0;
+    length_t high = previous_length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(previous[middle].hash < func->hash){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for(length_t i = low; i != previous_length && previous[i].hash == func->hash; i++){
+        call_graph_func_t *candidate = &previous[i];
+
+        // Calls that weren't found before are only useful if they can't be found now either
+        if(candidate->name == func->name && candidate->length == func->length && (candidate->has_sites || is_lazy)){
+            return candidate;
+        }
+    }
+
+    return NULL;
+}
+
+// ---------------- call_graph_update_t ----------------
+// How a file is being updated, for each object of a compiler
+typedef struct {
+    length_t file;
+    call_graph_func_t *previous;
+    length_t previous_length;
+    bool has_bodies;
+} call_graph_update_t;
+
+void call_graph_update(compiler_t *compiler, ast_t *ast){
+    length_t objects_length = compiler->objects_length;
+    call_graph_update_t *updates = calloc(objects_length, sizeof(call_graph_update_t));
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+
+        if(func->source.stride != 0 && func->source.object_index < objects_length && !(func->traits & AST_FUNC_LAZY_BODY)){
+            updates[func->source.object_index].has_bodies = true;
+        }
+    }
+
+    bool has_changed = false;
+
+    for(length_t i = 0; i != objects_length; i++){
+        object_t *object = compiler->objects[i];
+        updates[i].file = NAME_INDEX_NONE;
+
+        if(object->full_filename == NULL || object->full_filename[0] == '\0' || object->buffer == NULL) continue;
+
+        call_graph_file_t *file = call_graph_file(object->full_filename);
+
+        // Files are often compiled again without changing, such as when they're imported
+        text_version_t version = text_version(object->buffer_hash, object->buffer_length);
+        bool is_unchanged = text_version_is_current(&file->version, version);
+        if(is_unchanged && (file->is_complete || !updates[i].has_bodies)) continue;
+
+        file->version = version;
+        file->is_complete = true;
+        call_graph_index_lines(file, object->buffer, object->buffer_length);
+
+        // Previous functions are matched by the hash of their text
+        qsort(file->funcs, file->funcs_length, sizeof(call_graph_func_t), call_graph_compare_funcs_by_hash);
+
+        updates[i].file = file - files;
+        updates[i].previous = file->funcs;
+        updates[i].previous_length = file->funcs_length;
+
+        file->funcs = NULL;
+        file->funcs_length = 0;
+        file->funcs_capacity = 0;
+        has_changed = true;
+    }
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+        length_t object_index = func->source.object_index;
+
+        if(func->source.stride == 0 || object_index >= objects_length) continue;
+
+        call_graph_update_t *update = &updates[object_index];
+        object_t *object = compiler->objects[object_index];
+        if(update->file == NAME_INDEX_NONE || func->source.index >= object->buffer_length) continue;
+
+        call_graph_file_t *file = &files[update->file];
+        bool is_lazy = func->traits & AST_FUNC_LAZY_BODY;
+        const char *text = &object->buffer[func->source.index];
+
+        call_graph_func_t new_func = {
+            .name = call_graph_intern(func->name),
+            .begin = func->source.index,
+            .length = call_graph_func_length(object, func),
+        };
+
+        new_func.hash = hash_data(text, new_func.length);
+        new_func.name_offset = call_graph_name_offset(text, new_func.length, func->name);
+
+        call_graph_func_t *previous = call_graph_find_previous(update->previous, update->previous_length, &new_func, is_lazy);
+
+        if(previous){
+            new_func.has_sites = previous->has_sites;
+            new_func.sites_length = previous->sites_length;
+
+            if(previous->sites_length != 0){
+                new_func.sites = malloc(sizeof(call_graph_site_t) * previous->sites_length);
+                memcpy(new_func.sites, previous->sites, sizeof(call_graph_site_t) * previous->sites_length);
+            }
+        } else if(!is_lazy){
+            call_graph_walk_t walk = {
+                .object_index = object_index,
+                .begin = func->source.index,
+            };
+
+            call_graph_walk_list(&func->statements, &walk);
+            qsort(walk.sites, walk.sites_length, sizeof(call_graph_site_t), call_graph_compare_sites);
+
+            new_func.has_sites = true;
+            new_func.sites = walk.sites;
+            new_func.sites_length = walk.sites_length;
+        }
+
+        if(!new_func.has_sites) file->is_complete = false;
+
+        expand((void**) &file->funcs, sizeof(call_graph_func_t), file->funcs_length, &file->funcs_capacity, 1, 64);
+        file->funcs[file->funcs_length++] = new_func;
+    }
+
+    for(length_t i = 0; i != objects_length; i++){
+        call_graph_update_t *update = &updates[i];
+        if(update->file == NAME_INDEX_NONE) continue;
+
+        for(length_t j = 0; j != update->previous_length; j++){
+            free(update->previous[j].sites);
+        }
+        free(update->previous);
+
+        call_graph_file_t *file = &files[update->file];
+        qsort(file->funcs, file->funcs_length, sizeof(call_graph_func_t), call_graph_compare_funcs_by_begin);
+    }
+
+    if(has_changed) indices_are_stale = true;
+
+    free(updates);
+}
+
+void call_graph_forget(weak_cstr_t absolute){
+    call_graph_file_t *file = call_graph_find_file(absolute);
+    if(file == NULL) return;
+
+    for(length_t i = 0; i != file->funcs_length; i++){
+        free(file->funcs[i].sites);
+    }
+
+    free(file->funcs);
+    file->funcs = NULL;
+    file->funcs_length = 0;
+    file->funcs_capacity = 0;
+    file->version = (text_version_t){0};
+    indices_are_stale = true;
+}
+
+static void call_graph_index(void){
+    if(!indices_are_stale) return;
+
+    definitions_length = 0;
+    callers_length = 0;
+
+    for(length_t i = 0; i != files_length; i++){
+        call_graph_file_t *file = &files[i];
+
+        for(length_t j = 0; j != file->funcs_length; j++){
+            call_graph_func_t *func = &file->funcs[j];
+
+            expand((void**) &definitions, sizeof(call_graph_ref_t), definitions_length, &definitions_capacity, 1, 1024);
+            definitions[definitions_length++] = (call_graph_ref_t){func->name, i, j, 0};
+
+            for(length_t k = 0; k != func->sites_length; k++){
+                expand((void**) &callers, sizeof(call_graph_ref_t), callers_length, &callers_capacity, 1, 1024);
+                callers[callers_length++] = (call_graph_ref_t){func->sites[k].callee, i, j, k};
+            }
+        }
+    }
+
+    qsort(definitions, definitions_length, sizeof(call_graph_ref_t), call_graph_compare_refs);
+    qsort(callers, callers_length, sizeof(call_graph_ref_t), call_graph_compare_refs);
+    indices_are_stale = false;
+}
+
+static length_t call_graph_first_ref(call_graph_ref_t *refs, length_t refs_length, length_t name){
+    length_t low = 0;
+    length_t high = refs_length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(refs[middle].name < name){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+static length_t call_graph_find_func(call_graph_file_t *file, length_t begin){
+    length_t low = 0;
+    length_t high = file->funcs_length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(file->funcs[middle].begin < begin){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low != file->funcs_length && file->funcs[low].begin == begin ? low : NAME_INDEX_NONE;
+}
+
+static call_graph_item_t call_graph_item(length_t file_index, length_t func_index){
+    call_graph_file_t *file = &files[file_index];
+    call_graph_func_t *func = &file->funcs[func_index];
+    weak_cstr_t name = names[func->name];
+    length_t name_begin = func->begin + func->name_offset;
+
+    return (call_graph_item_t){
+        .name = name,
+        .absolute = file->absolute,
+        .begin = call_graph_position(file, func->begin),
+        .end = call_graph_position(file, func->begin + func->length),
+        .name_begin = call_graph_position(file, name_begin),
+        .name_end = call_graph_position(file, name_begin + strlen(name)),
+    };
+}
+
+static call_graph_call_t call_graph_call(call_graph_item_t item, length_t file_index, length_t func_index, length_t site_index){
+    call_graph_file_t *file = &files[file_index];
+    call_graph_func_t *func = &file->funcs[func_index];
+    call_graph_site_t *site = &func->sites[site_index];
+    length_t begin = func->begin + site->offset;
+
+    return (call_graph_call_t){
+        .item = item,
+        .begin = call_graph_position(file, begin),
+        .end = call_graph_position(file, begin + site->stride),
+    };
+}
+
+call_graph_item_list_t call_graph_find(weak_cstr_t name){
+    call_graph_item_list_t list = {0};
+    if(names == NULL) return list;
+
+    length_t id = name_index_find(&names_index, name);
+    if(id == NAME_INDEX_NONE) return list;
+
+    call_graph_index();
+
+    for(length_t i = call_graph_first_ref(definitions, definitions_length, id); i != definitions_length && definitions[i].name == id; i++){
+        list_append(&list, call_graph_item(definitions[i].file, definitions[i].func), call_graph_item_t);
+    }
+
+    return list;
+}
+
+call_graph_call_list_t call_graph_incoming(weak_cstr_t name){
+    call_graph_call_list_t list = {0};
+    if(names == NULL) return list;
+
+    length_t id = name_index_find(&names_index, name);
+    if(id == NAME_INDEX_NONE) return list;
+
+    call_graph_index();
+
+    for(length_t i = call_graph_first_ref(callers, callers_length, id); i != callers_length && callers[i].name == id; i++){
+        call_graph_ref_t *ref = &callers[i];
+        call_graph_item_t caller = call_graph_item(ref->file, ref->func);
+
+        list_append(&list, call_graph_call(caller, ref->file, ref->func, ref->site), call_graph_call_t);
+    }
+
+    return list;
+}
+
+call_graph_call_list_t call_graph_outgoing(weak_cstr_t absolute, call_graph_position_t begin){
+    call_graph_call_list_t list = {0};
+
+    call_graph_file_t *file = call_graph_find_file(absolute);
+    if(file == NULL || !file->version.is_known || begin.line >= file->lines_length) return list;
+
+    length_t func_index = call_graph_find_func(file, file->line_begins[begin.line] + begin.character);
+    if(func_index == NAME_INDEX_NONE) return list;
+
+    call_graph_index();
+
+    length_t file_index = file - files;
+    call_graph_func_t *func = &file->funcs[func_index];
+
+    // Sites are sorted by callee, so each run of sites calls the same functions
+    for(length_t run = 0; run != func->sites_length;){
+        length_t callee = func->sites[run].callee;
+        length_t run_end = run + 1;
+        while(run_end != func->sites_length && func->sites[run_end].callee == callee) run_end++;
+
+        for(length_t i = call_graph_first_ref(definitions, definitions_length, callee); i != definitions_length && definitions[i].name == callee; i++){
+            call_graph_item_t called = call_graph_item(definitions[i].file, definitions[i].func);
+
+            for(length_t site = run; site != run_end; site++){
+                list_append(&list, call_graph_call(called, file_index, func_index, site), call_graph_call_t);
+            }
+        }
+
+        run = run_end;
+    }
+
+    return list;
+}
+
+call_graph_count_list_t call_graph_count(compiler_t *compiler, ast_func_t *func){
+    call_graph_count_list_t list = {0};
+    if(func->source.object_index >= compiler->objects_length) return list;
+
+    object_t *object = compiler->objects[func->source.object_index];
+    call_graph_file_t *file = object->full_filename ? call_graph_find_file(object->full_filename) : NULL;
+    if(file == NULL) return list;
+
+    length_t func_index = call_graph_find_func(file, func->source.index);
+    if(func_index == NAME_INDEX_NONE) return list;
+
+    call_graph_index();
+
+    call_graph_func_t *found = &file->funcs[func_index];
+
+    // Only calls to functions that are known to the graph are counted
+    for(length_t run = 0; run != found->sites_length;){
+        length_t callee = found->sites[run].callee;
+        length_t run_end = run + 1;
+        while(run_end != found->sites_length && found->sites[run_end].callee == callee) run_end++;
+
+        length_t definition = call_graph_first_ref(definitions, definitions_length, callee);
+
+        if(definition != definitions_length && definitions[definition].name == callee){
+            list_append(&list, ((call_graph_count_t){
+                .name = names[callee],
+                .count = run_end - run,
+            }), call_graph_count_t);
+        }
+
+        run = run_end;
+    }
+
+    qsort(list.counts, list.length, sizeof(call_graph_count_t), call_graph_compare_counts);
+
+    return list;
+}
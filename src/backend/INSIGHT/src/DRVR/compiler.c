@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/UTIL/string_builder_extensions.h"
 #include "AST/ast.h"
 #include "AST/ast_dump.h"
@@ -28,10 +29,13 @@
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "DRVR/config.h"
+#include "DRVR/file_cache.h"
 #include "DRVR/object.h"
+#include "DRVR/overlay.h"
 #include "LEX/lex.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
+#include "UTIL/arena.h"
 #include "UTIL/color.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
@@ -226,12 +230,17 @@ bool handle_package_management(compiler_t *compiler, int argc, char **argv){
     return false;
 }
 
-void compiler_init(compiler_t *compiler){
+static void compiler_init_state(compiler_t *compiler){
+    #ifdef ADEPT_INSIGHT_BUILD
+    ast_type_table_init(&compiler->type_table, &compiler->arena);
+    #endif
+
     compiler->location = NULL;
     compiler->root = NULL;
     compiler->objects = malloc(sizeof(object_t*) * 4);
     compiler->objects_length = 0;
     compiler->objects_capacity = 4;
+    name_index_init(&compiler->objects_index);
     config_prepare(&compiler->config, NULL);
     compiler->config_filename = NULL;
     compiler->traits = TRAIT_NONE;
@@ -272,7 +281,15 @@ void compiler_init(compiler_t *compiler){
     compiler->deinit_point = NULL;
 }
 
-void compiler_free(compiler_t *compiler){
+void compiler_init(compiler_t *compiler){
+    #ifdef ADEPT_INSIGHT_BUILD
+    arena_init(&compiler->arena);
+    #endif
+
+    compiler_init_state(compiler);
+}
+
+static void compiler_free_state(compiler_t *compiler){
     free(compiler->location);
     free(compiler->root);
     free(compiler->output_filename);
@@ -285,12 +302,53 @@ void compiler_free(compiler_t *compiler){
     compiler_free_warnings(compiler);
     config_free(&compiler->config);
     free(compiler->config_filename);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    ast_type_table_free(&compiler->type_table);
+    #endif
+}
+
+#ifdef ADEPT_INSIGHT_BUILD
+void compiler_reset(compiler_t *compiler){
+    compiler_free_state(compiler);
+    arena_reset(&compiler->arena);
+    compiler_init_state(compiler);
+}
+#endif
+
+void compiler_free(compiler_t *compiler){
+    compiler_free_state(compiler);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    arena_free(&compiler->arena);
+    #endif
 }
 
+#ifdef ADEPT_INSIGHT_BUILD
+static void compiler_free_object_buffers(object_t *object){
+    // Buffers are freed regardless of compilation stage, since borrowed ones always have to be returned
+    if(object->traits & OBJECT_BORROWED_BUFFER){
+        file_cache_release(object->full_filename, object->buffer);
+    } else {
+        free(object->buffer);
+    }
+
+    for(length_t i = 0; i != object->retired_tokenlists_length; i++){
+        tokenlist_free(&object->retired_tokenlists[i]);
+    }
+
+    free(object->retired_tokenlists);
+}
+#endif
+
 void compiler_free_objects(compiler_t *compiler){
     for(length_t i = 0; i != compiler->objects_length; i++){
         object_t *object = compiler->objects[i];
 
+        #ifdef ADEPT_INSIGHT_BUILD
+        compiler_free_object_buffers(object);
+        #endif
+
         switch(object->compilation_stage){
         case COMPILATION_STAGE_IR_MODULE:
             #ifndef ADEPT_INSIGHT_BUILD
@@ -302,7 +360,9 @@ void compiler_free_objects(compiler_t *compiler){
             free(object->current_namespace);
             // fallthrough
         case COMPILATION_STAGE_TOKENLIST:
+            #ifndef ADEPT_INSIGHT_BUILD
             free(object->buffer);
+            #endif
             tokenlist_free(&object->tokenlist);
             // fallthrough
         case COMPILATION_STAGE_FILENAME:
@@ -320,10 +380,12 @@ void compiler_free_objects(compiler_t *compiler){
     }
 
     free(compiler->objects);
+    name_index_free(&compiler->objects_index);
     
     compiler->objects = NULL;
     compiler->objects_length = 0;
     compiler->objects_capacity = 0;
+    name_index_init(&compiler->objects_index);
 }
 
 void compiler_free_error(compiler_t *compiler){
@@ -891,9 +953,16 @@ errorcode_t compiler_read_file(compiler_t *compiler, object_t *object){
     if(filename_length >= 4 && streq(&object->filename[filename_length - 4], ".dep")){
         object_panic_plain(object, "Importing compressed package is no longer supported");
         return FAILURE;
-    } else {
-        return lex(compiler, object);
     }
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Prefer the unsaved contents of files that are open in the editor
+    if(object->full_filename && overlay_text_contents(object->full_filename, &object->buffer, &object->buffer_length)){
+        return lex_buffer(compiler, object);
+    }
+    #endif
+
+    return lex(compiler, object);
 }
 
 strong_cstr_t compiler_get_stdlib(compiler_t *compiler, object_t *optional_object){
@@ -1218,10 +1287,10 @@ func_id_list_t compiler_possibilities(compiler_t *compiler, object_t *object, we
     ast_t *ast = &object->ast;
     func_id_list_t list = {0};
 
-    for(length_t id = 0; id != ast->funcs_length; id++){
+    for(func_id_t id = ast_find_func(ast, name); id != INVALID_FUNC_ID; id = ast_find_next_func(ast, id)){
         ast_func_t *func = &ast->funcs[id];
 
-        if(streq(func->name, name) && (func->traits & (AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE | AST_FUNC_NO_SUGGEST)) == TRAIT_NONE){
+        if((func->traits & (AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE | AST_FUNC_NO_SUGGEST)) == TRAIT_NONE){
             if(methods_only_type_of_this){
                 if(!ast_func_is_method(func)) continue;
 
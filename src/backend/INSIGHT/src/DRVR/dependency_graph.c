@@ -0,0 +1,138 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/dependency_graph.h"
+#include "UTIL/ground.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
+#include "UTIL/util.h"
+
+// ---------------- dependency_graph_node_t ----------------
+// A single file and the files that it imports
+typedef struct {
+    strong_cstr_t absolute;
+    length_t *imports;
+    length_t imports_length;
+    length_t imports_capacity;
+
+    // Only used while finding dependents
+    bool affected;
+    bool visited;
+    bool excluded;
+} dependency_graph_node_t;
+
+static dependency_graph_node_t *nodes = NULL;
+static length_t nodes_length = 0;
+static length_t nodes_capacity = 0;
+static name_index_t nodes_index;
+
+static length_t dependency_graph_find(weak_cstr_t absolute){
+    if(nodes == NULL) return NAME_INDEX_NONE;
+    return name_index_find(&nodes_index, absolute);
+}
+
+static length_t dependency_graph_node(weak_cstr_t absolute){
+    length_t found = dependency_graph_find(absolute);
+    if(found != NAME_INDEX_NONE) return found;
+
+    if(nodes == NULL) name_index_init(&nodes_index);
+
+    expand((void**) &nodes, sizeof(dependency_graph_node_t), nodes_length, &nodes_capacity, 1, 16);
+
+    nodes[nodes_length] = (dependency_graph_node_t){
+        .absolute = strclone(absolute),
+    };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&nodes_index, nodes[nodes_length].absolute);
+    return nodes_length++;
+}
+
+void dependency_graph_forget_imports(weak_cstr_t importer){
+    length_t found = dependency_graph_find(importer);
+    if(found != NAME_INDEX_NONE) nodes[found].imports_length = 0;
+}
+
+void dependency_graph_add_import(weak_cstr_t importer, weak_cstr_t imported){
+    if(importer[0] == '\0' || imported[0] == '\0') return;
+
+    length_t from = dependency_graph_node(importer);
+    length_t to = dependency_graph_node(imported);
+    dependency_graph_node_t *node = &nodes[from];
+
+    for(length_t i = 0; i != node->imports_length; i++){
+        if(node->imports[i] == to) goto done;
+    }
+
+    expand((void**) &node->imports, sizeof(length_t), node->imports_length, &node->imports_capacity, 1, 4);
+    node->imports[node->imports_length++] = to;
+
+done:
+}
+
+static bool dependency_graph_imports_affected(dependency_graph_node_t *node){
+    for(length_t i = 0; i != node->imports_length; i++){
+        if(nodes[node->imports[i]].affected) return true;
+    }
+    return false;
+}
+
+static void dependency_graph_visit(length_t index, strong_cstr_list_t *out_dependents){
+    // Adds affected files in post-order, so that imported files come first
+    dependency_graph_node_t *node = &nodes[index];
+    if(!node->affected || node->visited) return;
+
+    node->visited = true;
+
+    for(length_t i = 0; i != node->imports_length; i++){
+        dependency_graph_visit(node->imports[i], out_dependents);
+    }
+
+    if(!node->excluded) strong_cstr_list_append(out_dependents, strclone(node->absolute));
+}
+
+strong_cstr_list_t dependency_graph_dependents(const strong_cstr_list_t *absolutes){
+    strong_cstr_list_t dependents = {0};
+
+    for(length_t i = 0; i != nodes_length; i++){
+        nodes[i].affected = false;
+        nodes[i].visited = false;
+        nodes[i].excluded = false;
+    }
+
+    for(length_t i = 0; i != absolutes->length; i++){
+        length_t found = dependency_graph_find(absolutes->items[i]);
+        if(found != NAME_INDEX_NONE) nodes[found].affected = true;
+    }
+
+    // Spread to importers until nothing changes
+    // NOTE: The graph is small enough that this is cheaper than maintaining reverse edges
+    bool changed;
+
+    do {
+        changed = false;
+
+        for(length_t i = 0; i != nodes_length; i++){
+            dependency_graph_node_t *node = &nodes[i];
+
+            if(!node->affected && dependency_graph_imports_affected(node)){
+                node->affected = true;
+                changed = true;
+            }
+        }
+    } while(changed);
+
+    // The given files themselves are left out, but their imports are still followed
+    for(length_t i = 0; i != absolutes->length; i++){
+        length_t found = dependency_graph_find(absolutes->items[i]);
+        if(found != NAME_INDEX_NONE) nodes[found].excluded = true;
+    }
+
+    for(length_t i = 0; i != nodes_length; i++){
+        dependency_graph_visit(i, &dependents);
+    }
+
+    return dependents;
+}
@@ -0,0 +1,139 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/file_cache.h"
+#include "UTIL/file_watcher.h"
+#include "UTIL/ground.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+// ---------------- file_cache_mapping_t ----------------
+// The contents of a file, which are either mapped or read into memory
+typedef struct {
+    const char *contents;
+    length_t length;
+    length_t borrowers;
+    bool is_mapped;
+} file_cache_mapping_t;
+
+// ---------------- file_cache_entry_t ----------------
+// The cached contents of a single file
+typedef struct {
+    strong_cstr_t absolute;
+    file_cache_mapping_t mapping; // 'contents' is NULL when unknown
+} file_cache_entry_t;
+
+static file_cache_entry_t *entries = NULL;
+static length_t entries_length = 0;
+static length_t entries_capacity = 0;
+static name_index_t entries_index;
+
+// Mappings that were forgotten while still being borrowed
+static file_cache_mapping_t *retired = NULL;
+static length_t retired_length = 0;
+static length_t retired_capacity = 0;
+
+static file_cache_entry_t *file_cache_lookup(weak_cstr_t absolute){
+    if(entries == NULL) return NULL;
+
+    length_t found = name_index_find(&entries_index, absolute);
+    return found == NAME_INDEX_NONE ? NULL : &entries[found];
+}
+
+static void file_cache_free_contents(file_cache_mapping_t *mapping){
+    if(mapping->is_mapped){
+        file_text_unmap(mapping->contents, mapping->length);
+    } else {
+        free((void*) mapping->contents);
+    }
+}
+
+static void file_cache_forget(file_cache_mapping_t *mapping){
+    if(mapping->contents == NULL) return;
+
+    if(mapping->borrowers == 0){
+        file_cache_free_contents(mapping);
+    } else {
+        expand((void**) &retired, sizeof(file_cache_mapping_t), retired_length, &retired_capacity, 1, 4);
+
+        retired[retired_length++] = *mapping;
+    }
+
+    mapping->contents = NULL;
+}
+
+bool file_cache_text_contents(weak_cstr_t filename, weak_cstr_t absolute, bool is_immutable, strong_cstr_t *out_contents, length_t *out_length, bool *out_borrowed){
+    file_cache_entry_t *entry = file_cache_lookup(absolute);
+
+    // Only files whose changes will be noticed can be cached
+    if((entry == NULL || entry->mapping.contents == NULL) && !file_watcher_watch(absolute)){
+        *out_borrowed = false;
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    if(entry == NULL){
+        if(entries == NULL) name_index_init(&entries_index);
+
+        expand((void**) &entries, sizeof(file_cache_entry_t), entries_length, &entries_capacity, 1, 16);
+        entry = &entries[entries_length++];
+        entry->absolute = strclone(absolute);
+        entry->mapping = (file_cache_mapping_t){0};
+
+        // NOTE: Filenames are never moved, so they can be borrowed by the index
+        name_index_add(&entries_index, entry->absolute);
+    }
+
+    if(entry->mapping.contents == NULL){
+        // Only files that are never edited in place are mapped, since others can be truncated while mapped
+
+        bool read = is_immutable
+            ? file_text_map(filename, &entry->mapping.contents, &entry->mapping.length)
+            : file_text_contents(filename, (strong_cstr_t*) &entry->mapping.contents, &entry->mapping.length, true);
+
+        if(!read){
+            entry->mapping.contents = NULL;
+            return false;
+        }
+
+        entry->mapping.is_mapped = is_immutable;
+    }
+
+    entry->mapping.borrowers++;
+    *out_contents = (strong_cstr_t) entry->mapping.contents;
+    *out_length = entry->mapping.length;
+    *out_borrowed = true;
+    return true;
+}
+
+void file_cache_release(weak_cstr_t absolute, const char *contents){
+    file_cache_entry_t *entry = file_cache_lookup(absolute);
+
+    if(entry && entry->mapping.contents == contents){
+        entry->mapping.borrowers--;
+        return;
+    }
+
+    for(length_t i = 0; i != retired_length; i++){
+        file_cache_mapping_t *mapping = &retired[i];
+        if(mapping->contents != contents) continue;
+
+        if(--mapping->borrowers == 0){
+            file_cache_free_contents(mapping);
+            *mapping = retired[--retired_length];
+        }
+        return;
+    }
+}
+
+void file_cache_invalidate(weak_cstr_t absolute){
+    file_cache_entry_t *entry = file_cache_lookup(absolute);
+    if(entry) file_cache_forget(&entry->mapping);
+}
+
+void file_cache_clear(void){
+    for(length_t i = 0; i != entries_length; i++){
+        file_cache_forget(&entries[i].mapping);
+    }
+}
@@ -0,0 +1,157 @@
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "DRVR/import_cache.h"
+#include "UTIL/file_watcher.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
+#include "UTIL/util.h"
+
+// ---------------- import_cache_entry_t ----------------
+// What is known about a single file that an import could resolve to
+typedef struct {
+    strong_cstr_t key; // The directory (including trailing slash) followed by the name
+    bool is_known;
+    bool exists;
+    maybe_null_strong_cstr_t absolute; // Determined when first needed
+
+    // Identity of the file, when it exists
+    dev_t device;
+    ino_t inode;
+
+    // Whether the file watcher will notice if the file is created or removed
+    bool watched;
+} import_cache_entry_t;
+
+static import_cache_entry_t *entries = NULL;
+static length_t entries_length = 0;
+static length_t entries_capacity = 0;
+static name_index_t entries_index;
+static bool entries_index_initialized = false;
+
+static strong_cstr_t import_cache_key(weak_cstr_t filename){
+    // Files are identified by directory and name the same way that the file watcher reports them
+    strong_cstr_t path = filename_path(filename);
+    strong_cstr_t key = mallocandsprintf("%s%s", path[0] == '\0' ? "./" : path, filename_name_const(filename));
+    free(path);
+    return key;
+}
+
+static import_cache_entry_t *import_cache_lookup(const char *key){
+    if(!entries_index_initialized) return NULL;
+
+    length_t found = name_index_find(&entries_index, key);
+    return found == NAME_INDEX_NONE ? NULL : &entries[found];
+}
+
+static import_cache_entry_t *import_cache_entry(weak_cstr_t filename){
+    strong_cstr_t key = import_cache_key(filename);
+    import_cache_entry_t *entry = import_cache_lookup(key);
+
+    if(entry){
+        free(key);
+        return entry;
+    }
+
+    if(!entries_index_initialized){
+        name_index_init(&entries_index);
+        entries_index_initialized = true;
+    }
+
+    expand((void**) &entries, sizeof(import_cache_entry_t), entries_length, &entries_capacity, 1, 16);
+
+    entry = &entries[entries_length++];
+    *entry = (import_cache_entry_t){
+        .key = key,
+    };
+
+    // NOTE: Keys are never moved, so they can be borrowed by the index
+    name_index_add(&entries_index, key);
+    return entry;
+}
+
+static void import_cache_forget(import_cache_entry_t *entry){
+    free(entry->absolute);
+    entry->absolute = NULL;
+    entry->is_known = false;
+}
+
+static bool import_cache_exists(weak_cstr_t filename, import_cache_entry_t *entry){
+    // Watched results are valid until the file watcher reports a change
+    if(entry->is_known && entry->watched) return entry->exists;
+
+    // Start watching before looking, so that changes in between aren't missed
+    bool watched = file_watcher_watch(filename);
+
+    struct stat info;
+    bool exists = stat(filename, &info) == 0 && !S_ISDIR(info.st_mode);
+
+    // The absolute filename can be reused as long as it's still the same file
+    if(entry->is_known && exists && entry->exists && info.st_dev == entry->device && info.st_ino == entry->inode){
+        entry->watched = watched;
+        return true;
+    }
+
+    import_cache_forget(entry);
+    entry->is_known = true;
+    entry->exists = exists;
+    entry->watched = watched;
+
+    if(exists){
+        entry->device = info.st_dev;
+        entry->inode = info.st_ino;
+    }
+
+    return exists;
+}
+
+maybe_index_t import_cache_resolve(const strong_cstr_list_t *candidates, maybe_null_strong_cstr_t *out_absolute, strong_cstr_list_t *out_missing){
+    for(length_t i = 0; i != candidates->length; i++){
+        weak_cstr_t candidate = candidates->items[i];
+        import_cache_entry_t *entry = import_cache_entry(candidate);
+        bool exists = import_cache_exists(candidate, entry);
+
+        if(entry->absolute == NULL){
+            entry->absolute = exists ? filename_absolute(candidate) : filename_absolute_maybe_missing(candidate);
+        }
+
+        if(exists){
+            *out_absolute = entry->absolute ? strclone(entry->absolute) : NULL;
+            return i;
+        }
+
+        if(entry->absolute) strong_cstr_list_append(out_missing, strclone(entry->absolute));
+    }
+
+    return -1;
+}
+
+void import_cache_invalidate(weak_cstr_t filename){
+    strong_cstr_t key = import_cache_key(filename);
+    import_cache_entry_t *entry = import_cache_lookup(key);
+    free(key);
+
+    if(entry) import_cache_forget(entry);
+}
+
+void import_cache_clear(void){
+    for(length_t i = 0; i != entries_length; i++){
+        free(entries[i].key);
+        free(entries[i].absolute);
+    }
+
+    free(entries);
+    entries = NULL;
+    entries_length = 0;
+    entries_capacity = 0;
+
+    if(entries_index_initialized){
+        name_index_free(&entries_index);
+        entries_index_initialized = false;
+    }
+}
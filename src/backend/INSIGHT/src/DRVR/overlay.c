@@ -0,0 +1,88 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/overlay.h"
+#include "UTIL/file_watcher.h"
+#include "UTIL/ground.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+// ---------------- overlay_entry_t ----------------
+// The unsaved contents of a single file
+typedef struct {
+    strong_cstr_t absolute;
+    maybe_null_strong_cstr_t contents; // NULL when the file isn't open
+    length_t length;
+} overlay_entry_t;
+
+static overlay_entry_t *entries = NULL;
+static length_t entries_length = 0;
+static length_t entries_capacity = 0;
+static name_index_t entries_index;
+
+static overlay_entry_t *overlay_lookup(weak_cstr_t absolute){
+    if(entries == NULL) return NULL;
+
+    length_t found = name_index_find(&entries_index, absolute);
+    return found == NAME_INDEX_NONE ? NULL : &entries[found];
+}
+
+void overlay_set(weak_cstr_t absolute, const char *contents, length_t length){
+    if(overlay_matches(absolute, contents, length)) return;
+
+    overlay_entry_t *entry = overlay_lookup(absolute);
+
+    if(entry == NULL){
+        if(entries == NULL) name_index_init(&entries_index);
+
+        expand((void**) &entries, sizeof(overlay_entry_t), entries_length, &entries_capacity, 1, 16);
+        entry = &entries[entries_length++];
+        entry->absolute = strclone(absolute);
+        entry->contents = NULL;
+
+        // NOTE: Filenames are never moved, so they can be borrowed by the index
+        name_index_add(&entries_index, entry->absolute);
+    }
+
+    // NOTE: Includes the null termination after the contents
+    free(entry->contents);
+    entry->contents = malloc(length + 1);
+    entry->length = length;
+    memcpy(entry->contents, contents, length + 1);
+
+    file_watcher_notify_unsaved(absolute);
+}
+
+void overlay_remove(weak_cstr_t absolute){
+    overlay_entry_t *entry = overlay_lookup(absolute);
+    if(entry == NULL || entry->contents == NULL) return;
+
+    free(entry->contents);
+    entry->contents = NULL;
+
+    file_watcher_notify(absolute, false);
+}
+
+bool overlay_exists(weak_cstr_t absolute){
+    overlay_entry_t *entry = overlay_lookup(absolute);
+    return entry && entry->contents;
+}
+
+bool overlay_matches(weak_cstr_t absolute, const char *contents, length_t length){
+    overlay_entry_t *entry = overlay_lookup(absolute);
+
+    return entry && entry->contents && entry->length == length
+        && memcmp(entry->contents, contents, length) == 0;
+}
+
+bool overlay_text_contents(weak_cstr_t absolute, strong_cstr_t *out_contents, length_t *out_length){
+    overlay_entry_t *entry = overlay_lookup(absolute);
+    if(entry == NULL || entry->contents == NULL) return false;
+
+    *out_contents = malloc(entry->length + 1);
+    *out_length = entry->length;
+    memcpy(*out_contents, entry->contents, entry->length + 1);
+    return true;
+}
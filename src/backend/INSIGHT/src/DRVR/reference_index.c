@@ -0,0 +1,272 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/reference_index.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+// ---------------- reference_posting_t ----------------
+// A single appearance of an interned identifier within a file
+typedef struct {
+    length_t identifier;
+    length_t line;
+    length_t character;
+    length_t stride;
+    bool is_declaration;
+} reference_posting_t;
+
+// ---------------- reference_file_t ----------------
+// The postings of a file, sorted by identifier and then by location
+typedef struct {
+    strong_cstr_t absolute;
+    text_version_t version;
+    reference_posting_t *postings;
+    length_t postings_length;
+    length_t postings_capacity;
+} reference_file_t;
+
+// ---------------- reference_identifier_t ----------------
+// An interned identifier, along with how many postings use it
+typedef struct {
+    strong_cstr_t name;
+    length_t references;
+} reference_identifier_t;
+
+static reference_identifier_t *identifiers = NULL;
+static length_t identifiers_length = 0;
+static length_t identifiers_capacity = 0;
+static length_t identifiers_unused = 0;
+static name_index_t identifiers_index;
+
+static reference_file_t *files = NULL;
+static length_t files_length = 0;
+static length_t files_capacity = 0;
+static name_index_t files_index;
+
+void reference_list_free(reference_list_t *list){
+    free(list->references);
+}
+
+static length_t reference_index_intern(weak_cstr_t name){
+    if(identifiers == NULL) name_index_init(&identifiers_index);
+
+    length_t found = name_index_find(&identifiers_index, name);
+
+    if(found != NAME_INDEX_NONE){
+        if(identifiers[found].references++ == 0) identifiers_unused--;
+        return found;
+    }
+
+    expand((void**) &identifiers, sizeof(reference_identifier_t), identifiers_length, &identifiers_capacity, 1, 1024);
+
+    identifiers[identifiers_length] = (reference_identifier_t){
+        .name = strclone(name),
+        .references = 1,
+    };
+
+    // NOTE: Names of identifiers are never moved, so they can be borrowed by the index
+    name_index_add(&identifiers_index, identifiers[identifiers_length].name);
+    return identifiers_length++;
+}
+
+static void reference_index_release(reference_file_t *file){
+    for(length_t i = 0; i != file->postings_length; i++){
+        if(--identifiers[file->postings[i].identifier].references == 0) identifiers_unused++;
+    }
+}
+
+static void reference_index_compact(void){
+    // Only compact once most identifiers are unused, since every posting has to be renumbered
+    if(identifiers_unused < 1024 || identifiers_unused * 2 < identifiers_length) return;
+
+    // Surviving identifiers keep their relative order, so postings stay sorted when renumbered
+    length_t *renumbered = malloc(sizeof(length_t) * identifiers_length);
+    length_t kept = 0;
+
+    name_index_free(&identifiers_index);
+    name_index_init(&identifiers_index);
+
+    for(length_t i = 0; i != identifiers_length; i++){
+        if(identifiers[i].references == 0){
+            free(identifiers[i].name);
+            continue;
+        }
+
+        renumbered[i] = kept;
+        identifiers[kept] = identifiers[i];
+        name_index_add(&identifiers_index, identifiers[kept++].name);
+    }
+
+    for(length_t i = 0; i != files_length; i++){
+        reference_file_t *file = &files[i];
+
+        for(length_t j = 0; j != file->postings_length; j++){
+            file->postings[j].identifier = renumbered[file->postings[j].identifier];
+        }
+    }
+
+    free(renumbered);
+    identifiers_length = kept;
+    identifiers_unused = 0;
+}
+
+static reference_file_t *reference_index_find_file(weak_cstr_t absolute){
+    if(files == NULL) return NULL;
+
+    length_t found = name_index_find(&files_index, absolute);
+    return found != NAME_INDEX_NONE ? &files[found] : NULL;
+}
+
+static reference_file_t *reference_index_file(weak_cstr_t absolute){
+    reference_file_t *file = reference_index_find_file(absolute);
+    if(file) return file;
+
+    if(files == NULL) name_index_init(&files_index);
+
+    expand((void**) &files, sizeof(reference_file_t), files_length, &files_capacity, 1, 64);
+
+    files[files_length] = (reference_file_t){
+        .absolute = strclone(absolute),
+    };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&files_index, files[files_length].absolute);
+    return &files[files_length++];
+}
+
+static bool reference_index_is_declaration(tokenid_t previous){
+    switch(previous){
+    case TOKEN_FUNC:
+    case TOKEN_FOREIGN:
+    case TOKEN_STRUCT:
+    case TOKEN_UNION:
+    case TOKEN_RECORD:
+    case TOKEN_CLASS:
+    case TOKEN_ENUM:
+    case TOKEN_ALIAS:
+    case TOKEN_DEFINE:
+        return true;
+    }
+    return false;
+}
+
+static int reference_index_compare(const void *a, const void *b){
+    const reference_posting_t *first = a;
+    const reference_posting_t *second = b;
+
+    if(first->identifier != second->identifier) return first->identifier < second->identifier ? -1 : 1;
+    if(first->line != second->line) return first->line < second->line ? -1 : 1;
+    return first->character < second->character ? -1 : first->character > second->character;
+}
+
+void reference_index_update(weak_cstr_t absolute, tokenlist_t *tokenlist, const char *buffer, text_version_t version){
+    if(absolute == NULL || absolute[0] == '\0') return;
+
+    reference_file_t *file = reference_index_file(absolute);
+
+    // Files are often lexed again without changing, such as when they're imported
+    if(text_version_is_current(&file->version, version)) return;
+
+    reference_index_release(file);
+    file->version = version;
+    file->postings_length = 0;
+
+    token_t *tokens = tokenlist->tokens;
+    source_t *sources = tokenlist->sources;
+
+    // Lines only have to be counted since the previous identifier
+    length_t scanned = 0;
+    length_t line = 0;
+    length_t line_begin = 0;
+
+    for(length_t i = 0; i != tokenlist->length; i++){
+        if(tokens[i].id != TOKEN_WORD) continue;
+
+        source_t source = sources[i];
+
+        for(; scanned < source.index; scanned++){
+            if(buffer[scanned] == '\n'){
+                line++;
+                line_begin = scanned + 1;
+            }
+        }
+
+        expand((void**) &file->postings, sizeof(reference_posting_t), file->postings_length, &file->postings_capacity, 1, 256);
+
+        file->postings[file->postings_length++] = (reference_posting_t){
+            .identifier = reference_index_intern((weak_cstr_t) tokens[i].data),
+            .line = line,
+            .character = source.index - line_begin,
+            .stride = source.stride,
+            .is_declaration = i != 0 && reference_index_is_declaration(tokens[i - 1].id),
+        };
+    }
+
+    qsort(file->postings, file->postings_length, sizeof(reference_posting_t), reference_index_compare);
+    reference_index_compact();
+}
+
+void reference_index_forget(weak_cstr_t absolute){
+    reference_file_t *file = reference_index_find_file(absolute);
+    if(file == NULL) return;
+
+    reference_index_release(file);
+    free(file->postings);
+    file->version = (text_version_t){0};
+    file->postings = NULL;
+    file->postings_length = 0;
+    file->postings_capacity = 0;
+    reference_index_compact();
+}
+
+static void reference_index_find_in_file(reference_file_t *file, length_t identifier, reference_list_t *out_list){
+    // Find the first posting of the identifier
+    length_t low = 0;
+    length_t high = file->postings_length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(file->postings[middle].identifier < identifier){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for(length_t i = low; i != file->postings_length && file->postings[i].identifier == identifier; i++){
+        reference_posting_t *posting = &file->postings[i];
+
+        reference_list_append(out_list, ((reference_t){
+            .absolute = file->absolute,
+            .line = posting->line,
+            .character = posting->character,
+            .stride = posting->stride,
+            .is_declaration = posting->is_declaration,
+        }));
+    }
+}
+
+reference_list_t reference_index_find(weak_cstr_t name, maybe_null_weak_cstr_t only_absolute){
+    reference_list_t list = {0};
+    if(identifiers == NULL) return list;
+
+    length_t identifier = name_index_find(&identifiers_index, name);
+    if(identifier == NAME_INDEX_NONE) return list;
+
+    if(only_absolute){
+        reference_file_t *file = reference_index_find_file(only_absolute);
+        if(file) reference_index_find_in_file(file, identifier, &list);
+    } else {
+        for(length_t i = 0; i != files_length; i++){
+            reference_index_find_in_file(&files[i], identifier, &list);
+        }
+    }
+
+    return list;
+}
@@ -5,7 +5,9 @@
 #include <string.h>
 
 #include "DRVR/compiler.h"
+#include "DRVR/file_cache.h"
 #include "DRVR/object.h"
+#include "DRVR/reference_index.h"
 #include "LEX/lex.h"
 #include "LEX/token.h"
 #include "TOKEN/token_data.h"
@@ -13,6 +15,7 @@
 #include "UTIL/datatypes.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "UTIL/search.h"
 #include "UTIL/string.h"
 #include "UTIL/util.h"
@@ -511,8 +514,34 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
     ctx->i += size + flag_length;
 }
 
+#ifdef ADEPT_INSIGHT_BUILD
+static bool lex_is_infrastructure_file(compiler_t *compiler, weak_cstr_t absolute){
+    // Files of the infrastructure, such as the standard library, are never edited in place
+    // NOTE: Infrastructures that aren't given as absolute paths are never matched,
+    //       which is safe, since their files are only read instead of mapped
+    weak_cstr_t root = compiler->root;
+    if(root == NULL || root[0] == '\0') return false;
+
+    length_t length = strlen(root);
+    if(root[length - 1] == '/' || root[length - 1] == '\\') length--;
+
+    return strncmp(root, absolute, length) == 0 && (absolute[length] == '/' || absolute[length] == '\\');
+}
+#endif
+
 errorcode_t lex(compiler_t *compiler, object_t *object){
-    if(!file_text_contents(object->filename, &object->buffer, &object->buffer_length, true)){
+    #ifdef ADEPT_INSIGHT_BUILD
+    bool borrowed = false;
+    bool read = object->full_filename
+        ? file_cache_text_contents(object->filename, object->full_filename, lex_is_infrastructure_file(compiler, object->full_filename), &object->buffer, &object->buffer_length, &borrowed)
+        : file_text_contents(object->filename, &object->buffer, &object->buffer_length, true);
+
+    if(borrowed) object->traits |= OBJECT_BORROWED_BUFFER;
+    #else
+    bool read = file_text_contents(object->filename, &object->buffer, &object->buffer_length, true);
+    #endif
+
+    if(!read){
         redprintf("The file '%s' doesn't exist or can't be accessed\n", object->filename);
         return FAILURE;
     }
@@ -528,6 +557,11 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
     length_t buffer_length = object->buffer_length;
     length_t estimate = buffer_length / 3;
 
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Hashed once here, so that every index kept per file can tell whether it changed
+    object->buffer_hash = hash_data(buffer, buffer_length);
+    #endif
+
     lex_ctx_t ctx = (lex_ctx_t){
         .buffer = buffer,
         .buffer_length = buffer_length,
@@ -675,6 +709,11 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
         }
     }
 
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Identifiers are indexed while the words are still around
+    reference_index_update(object->full_filename, &ctx.tokenlist, buffer, text_version(object->buffer_hash, buffer_length));
+    #endif
+
     object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
     object->tokenlist = ctx.tokenlist;
     return SUCCESS;
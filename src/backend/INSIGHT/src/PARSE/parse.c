@@ -4,7 +4,9 @@
 
 #include "AST/ast.h"
 #include "BRIDGE/any.h"
+#include "BRIDGE/prelude.h"
 #include "DRVR/compiler.h"
+#include "DRVR/dependency_graph.h"
 #include "DRVR/object.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
@@ -27,10 +29,19 @@ errorcode_t parse(compiler_t *compiler, object_t *object){
 
     object_init_ast(object, compiler->cross_compile_for);
     parse_ctx_init(&ctx, compiler, object);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Imports are recorded again as they are parsed
+    dependency_graph_forget_imports(object->full_filename);
+    #endif
     
     if(!(compiler->traits & COMPILER_INFLATE_PACKAGE)){
+        #ifdef ADEPT_INSIGHT_BUILD
+        prelude_link_ast(compiler, ctx.ast);
+        #else
         any_inject_ast(ctx.ast);
         va_args_inject_ast(compiler, ctx.ast);
+        #endif
     }
     
     if(parse_tokens(&ctx)){
@@ -1,6 +1,7 @@
 
 #include <stdlib.h>
 
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast.h"
 #include "AST/ast_type_lean.h"
 #include "DRVR/compiler.h"
@@ -69,6 +70,13 @@ errorcode_t parse_alias(parse_ctx_t *ctx){
     }
 
     ast_add_alias(ast, name, type, generics, generics_length, TRAIT_NONE, source);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    // The type is only read from now on, so share its canonical instance
+    ast_alias_t *alias = &ast->aliases[ast->aliases_length - 1];
+    alias->is_type_shared = ast_type_table_canonicalize(&ctx->compiler->type_table, &alias->type);
+    #endif
+
     return SUCCESS;
 
 failure:
@@ -30,6 +30,7 @@ void parse_ctx_init(parse_ctx_t *ctx, compiler_t *compiler, object_t *object){
     ctx->prename = NULL;
     ctx->struct_closer = TOKEN_CLOSE;
     ctx->struct_closer_char = ')';
+    ctx->skip_func_bodies = false;
 }
 
 void parse_ctx_fork(parse_ctx_t *ctx, object_t *new_object, parse_ctx_t *out_ctx_fork){
@@ -6,6 +6,8 @@
 
 #include "AST/ast.h"
 #include "DRVR/compiler.h"
+#include "DRVR/dependency_graph.h"
+#include "DRVR/import_cache.h"
 #include "DRVR/object.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
@@ -14,6 +16,7 @@
 #include "TOKEN/token_data.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
+#include "UTIL/name_index.h"
 #include "UTIL/string.h"
 #include "UTIL/string_list.h"
 #include "UTIL/util.h"
@@ -70,9 +73,9 @@ errorcode_t parse_import(parse_ctx_t *ctx){
 }
 
 errorcode_t parse_do_import(parse_ctx_t *ctx, weak_cstr_t file, source_t source, bool allow_local){
-    maybe_null_strong_cstr_t target = parse_find_import(ctx, file, source, allow_local);
+    strong_cstr_t target, absolute;
 
-    if(target == NULL){
+    if(parse_locate_import(ctx, file, source, allow_local, &target, &absolute)){
         if(!allow_local){
             printf("\nPerhaps you are using the wrong standard library version?\n\n");
         }
@@ -80,11 +83,9 @@ errorcode_t parse_do_import(parse_ctx_t *ctx, weak_cstr_t file, source_t source,
         return FAILURE;
     }
 
-    maybe_null_strong_cstr_t absolute = parse_resolve_import(ctx, target);
-    if(absolute == NULL){
-        free(target);
-        return FAILURE;
-    }
+    #ifdef ADEPT_INSIGHT_BUILD
+    dependency_graph_add_import(ctx->object->full_filename, absolute);
+    #endif
 
     if(already_imported(ctx, absolute)){
         free(target);
@@ -143,10 +144,15 @@ errorcode_t parse_import_object(parse_ctx_t *ctx, strong_cstr_t relative_filenam
     new_object->filename = relative_filename;
     new_object->full_filename = absolute_filename;
 
+    #ifdef ADEPT_INSIGHT_BUILD
+    dependency_graph_forget_imports(absolute_filename);
+    #endif
+
     if(compiler_read_file(ctx->compiler, new_object)) return FAILURE;
 
     parse_ctx_t ctx_fork;
     parse_ctx_fork(ctx, new_object, &ctx_fork);
+    ctx_fork.skip_func_bodies = ctx->compiler->traits & COMPILER_SKIP_IMPORTED_BODIES;
 
     if(parse_tokens(&ctx_fork)) return FAILURE;
 
@@ -200,32 +206,96 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
     return full_component ? full_component : strclone(first_part_of_component);
 }
 
-maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import){
-    strong_cstr_t test;
+strong_cstr_list_t parse_import_candidates(parse_ctx_t *ctx, weak_cstr_t filename, bool allow_local_import){
+    strong_cstr_list_t candidates = {0};
 
     if(allow_local_import){
-        test = filename_local(ctx->object->filename, filename);
-        if(file_exists(test)) return test;
-        free(test);
+        strong_cstr_list_append(&candidates, filename_local(ctx->object->filename, filename));
     }
 
-    test = filename_adept_import(ctx->compiler->root, filename);
-    if(file_exists(test)) return test;
-    free(test);
+    strong_cstr_list_append(&candidates, filename_adept_import(ctx->compiler->root, filename));
 
     for(length_t i = 0; i != ctx->compiler->user_search_paths.length; i++){
         weak_cstr_t path = ctx->compiler->user_search_paths.items[i];
         length_t path_length = strlen(path);
         
         bool append_slash = path_length && path[path_length - 1] != '/' && path[path_length - 1] != '\\';
-        test = mallocandsprintf(append_slash ? "%s/%s" : "%s%s", path, filename);
-        if(file_exists(test)) return test;
+        strong_cstr_list_append(&candidates, mallocandsprintf(append_slash ? "%s/%s" : "%s%s", path, filename));
+    }
+
+    return candidates;
+}
 
-        free(test);
+static maybe_index_t parse_find_import_candidate(strong_cstr_list_t *candidates){
+    for(length_t i = 0; i != candidates->length; i++){
+        if(file_exists(candidates->items[i])) return i;
     }
-    
-    compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
-    return NULL;
+    return -1;
+}
+
+maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import){
+    strong_cstr_list_t candidates = parse_import_candidates(ctx, filename, allow_local_import);
+    maybe_index_t found = parse_find_import_candidate(&candidates);
+
+    if(found < 0){
+        strong_cstr_list_free(&candidates);
+        compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
+        return NULL;
+    }
+
+    strong_cstr_t target = candidates.items[found];
+    candidates.items[found] = NULL;
+    strong_cstr_list_free(&candidates);
+    return target;
+}
+
+errorcode_t parse_locate_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import, strong_cstr_t *out_target, strong_cstr_t *out_absolute){
+    #ifdef ADEPT_INSIGHT_BUILD
+    // Which candidates exist is usually already known from previous queries
+    strong_cstr_list_t candidates = parse_import_candidates(ctx, filename, allow_local_import);
+    strong_cstr_list_t missing = {0};
+    maybe_index_t found = import_cache_resolve(&candidates, out_absolute, &missing);
+
+    // Creating any of the missing candidates would change what the import resolves to,
+    // so the importing file depends on them even though they don't exist
+    for(length_t i = 0; i != missing.length; i++){
+        dependency_graph_add_import(ctx->object->full_filename, missing.items[i]);
+    }
+
+    strong_cstr_list_free(&missing);
+
+    if(found < 0){
+        strong_cstr_list_free(&candidates);
+        compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
+        return FAILURE;
+    }
+
+    if(*out_absolute == NULL){
+        *out_absolute = parse_resolve_import(ctx, candidates.items[found]);
+
+        if(*out_absolute == NULL){
+            strong_cstr_list_free(&candidates);
+            return FAILURE;
+        }
+    }
+
+    *out_target = candidates.items[found];
+    candidates.items[found] = NULL;
+    strong_cstr_list_free(&candidates);
+    return SUCCESS;
+    #else
+    *out_target = parse_find_import(ctx, filename, source, allow_local_import);
+    if(*out_target == NULL) return FAILURE;
+
+    *out_absolute = parse_resolve_import(ctx, *out_target);
+
+    if(*out_absolute == NULL){
+        free(*out_target);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+    #endif
 }
 
 maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t filename){
@@ -239,9 +309,18 @@ maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t file
 bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename){
     object_t **objects = ctx->compiler->objects;
     length_t objects_length = ctx->compiler->objects_length;
+    name_index_t *index = &ctx->compiler->objects_index;
+
+    // Catch up on objects whose absolute filenames are known
+    while(index->length != objects_length && objects[index->length]->full_filename){
+        name_index_add(index, objects[index->length]->full_filename);
+    }
+
+    if(name_index_find(index, filename) != NAME_INDEX_NONE) return true;
 
-    for(length_t i = 0; i != objects_length; i++){
-        if(streq(objects[i]->full_filename, filename)) return true;
+    // Objects that don't have an absolute filename yet can't be indexed
+    for(length_t i = index->length; i != objects_length; i++){
+        if(objects[i]->full_filename && streq(objects[i]->full_filename, filename)) return true;
     }
 
     return false;
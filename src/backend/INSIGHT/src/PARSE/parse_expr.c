@@ -187,7 +187,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
             if(special_result){
                 value = special_result;
             } else {
-                meta_definition_t *definition = meta_definition_find(ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, transcendant_name);
+                meta_definition_t *definition = ast_find_meta_definition(ctx->ast, transcendant_name);
 
                 if(definition == NULL){
                     compiler_panicf(ctx->compiler, sources[*i - 1], "Transcendant variable '%s' does not exist", transcendant_name);
@@ -774,6 +774,8 @@ errorcode_t parse_expr_call(parse_ctx_t *ctx, ast_expr_t **out_expr, bool allow_
         }
 
         *out_expr = ast_expr_create_super(args, arity, is_tentative, source);
+        ast_type_free(&gives);
+        free(name);
     } else {
         *out_expr = ast_expr_create_call(name, arity, args, is_tentative, &gives, source);
     }
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "AST/TYPE/ast_type_make.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_type.h"
@@ -208,6 +209,13 @@ errorcode_t parse_func(parse_ctx_t *ctx){
         parse_func_solidify_constructor(ctx->compiler, ast, func, source);
     }
 
+    #ifdef ADEPT_INSIGHT_BUILD
+    // The signature is only read from now on, so share canonical instances of its types
+    func = &ast->funcs[ast_func_id];
+    func->is_signature_shared = ast_type_table_canonicalize_all(&ctx->compiler->type_table, func->arg_types, func->arity)
+        && ast_type_table_canonicalize_all(&ctx->compiler->type_table, &func->return_type, 1);
+    #endif
+
     return SUCCESS;
 }
 
@@ -405,6 +413,27 @@ errorcode_t parse_func_body(parse_ctx_t *ctx, ast_func_t *func){
         return SUCCESS;
     }
 
+    #ifdef ADEPT_INSIGHT_BUILD
+    if(parse_ctx_peek(ctx) == TOKEN_BEGIN){
+        func->body_token_index = *ctx->i;
+
+        // Remember the composite domain, so the body can be parsed again on its own later.
+        // NOTE: Pre-names are only ever used by heads, so they don't need to be remembered
+        ast_poly_composite_t *composite = ctx->composite_association;
+
+        if(composite){
+            func->composite_association_is_polymorphic = composite->is_polymorphic;
+            func->composite_association = composite->is_polymorphic
+                ? (length_t) (composite - ctx->ast->poly_composites)
+                : (length_t) ((ast_composite_t*) composite - ctx->ast->composites);
+        }
+
+        if(ctx->skip_func_bodies){
+            return parse_func_skip_body(ctx, func);
+        }
+    }
+    #endif
+
     if(parse_eat(ctx, TOKEN_BEGIN, "Expected '{' after function prototype")) return FAILURE;
 
     stmts = ast_expr_list_create(16);
@@ -427,6 +456,84 @@ success:
     return SUCCESS;
 }
 
+#ifdef ADEPT_INSIGHT_BUILD
+errorcode_t parse_func_skip_body(parse_ctx_t *ctx, ast_func_t *func){
+    // NOTE: Assumes 'i' is pointing to the opening '{' token
+
+    length_t *i = ctx->i;
+    token_t *tokens = ctx->tokenlist->tokens;
+    length_t tokens_length = ctx->tokenlist->length;
+    length_t begin = *i;
+    length_t depth = 0;
+
+    for(; *i != tokens_length; (*i)++){
+        tokenid_t id = tokens[*i].id;
+
+        if(id == TOKEN_META){
+            // Bodies with meta directives are parsed right away instead, since directives like '#set'
+            // and '#define' affect everything after them, and braces only balance within each '#if' branch
+            *i = begin;
+            ctx->skip_func_bodies = false;
+            errorcode_t errorcode = parse_func_body(ctx, func);
+            ctx->skip_func_bodies = true;
+            return errorcode;
+        }
+
+        if(id == TOKEN_BEGIN){
+            depth++;
+        } else if(id == TOKEN_END && --depth == 0){
+            func->traits |= AST_FUNC_LAZY_BODY;
+            func->end_source = ctx->tokenlist->sources[*i];
+            return SUCCESS;
+        }
+    }
+
+    *i = begin;
+    compiler_panic(ctx->compiler, ctx->tokenlist->sources[begin], "Function body is missing closing '}'");
+    return FAILURE;
+}
+
+errorcode_t parse_func_lazy_body(compiler_t *compiler, ast_t *ast, func_id_t func_id){
+    ast_func_t *func = &ast->funcs[func_id];
+    if(!(func->traits & AST_FUNC_LAZY_BODY)) return SUCCESS;
+
+    func->traits &= ~AST_FUNC_LAZY_BODY;
+
+    source_t skipped_end = func->end_source;
+    if(parse_func_reparse_body(compiler, ast, func_id)) return FAILURE;
+
+    // Guard against skipping having ended the body somewhere other than the parser does,
+    // since everything after a wrongly skipped body is parsed out of place
+    if(func->end_source.index != skipped_end.index){
+        compiler_panic(compiler, func->end_source, "Function body ends at a different '}' than when it was skipped");
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t parse_func_reparse_body(compiler_t *compiler, ast_t *ast, func_id_t func_id){
+    ast_func_t *func = &ast->funcs[func_id];
+    object_t *object = compiler->objects[func->source.object_index];
+    length_t i = func->body_token_index;
+
+    parse_ctx_t ctx;
+    parse_ctx_init(&ctx, compiler, object);
+    ctx.ast = ast;
+    ctx.i = &i;
+
+    if(func->composite_association != (length_t) -1){
+        ctx.composite_association = func->composite_association_is_polymorphic
+            ? &ast->poly_composites[func->composite_association]
+            : (ast_poly_composite_t*) &ast->composites[func->composite_association];
+    }
+
+    ast_expr_list_free(&func->statements);
+    func->statements = (ast_expr_list_t){0};
+    return parse_func_body(&ctx, func);
+}
+#endif
+
 errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
     length_t *i = ctx->i;
     token_t *tokens = ctx->tokenlist->tokens;
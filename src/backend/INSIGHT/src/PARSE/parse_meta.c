@@ -109,7 +109,7 @@ static errorcode_t parse_meta_directive_default(parse_ctx_t *ctx){
     if(parse_meta_expr(ctx, &value)) return FAILURE;
     if(meta_collapse(ctx->compiler, ctx->object, ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, &value)) return FAILURE;
 
-    meta_definition_t *existing = meta_definition_find(ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, definition_name);
+    meta_definition_t *existing = ast_find_meta_definition(ctx->ast, definition_name);
 
     if(existing == NULL){
         meta_definition_add(&ctx->ast->meta_definitions, &ctx->ast->meta_definitions_length, &ctx->ast->meta_definitions_capacity, definition_name, value);
@@ -331,18 +331,11 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
             
             *i = old_i;
             
-            maybe_null_strong_cstr_t target = parse_find_import(ctx, file, source, true);
+            strong_cstr_t target, absolute;
+            errorcode_t errorcode = parse_locate_import(ctx, file, source, true, &target, &absolute);
             free(file);
 
-            if(target == NULL){
-                return FAILURE;
-            }
-
-            maybe_null_strong_cstr_t absolute = parse_resolve_import(ctx, target);
-            if(absolute == NULL){
-                free(target);
-                return FAILURE;
-            }
+            if(errorcode) return FAILURE;
 
             if(already_imported(ctx, absolute)){
                 free(target);
@@ -368,7 +361,7 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
                 .value = strclone(input_str),
             });
 
-            meta_definition_t *existing = meta_definition_find(ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, definition_name);
+            meta_definition_t *existing = ast_find_meta_definition(ctx->ast, definition_name);
 
             if(existing){
                 meta_expr_free_fully(existing->value);
@@ -538,7 +531,7 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
             if(parse_meta_expr(ctx, &value)) return FAILURE;
             if(meta_collapse(ctx->compiler, ctx->object, ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, &value)) return FAILURE;
             
-            meta_definition_t *existing = meta_definition_find(ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, definition_name);
+            meta_definition_t *existing = ast_find_meta_definition(ctx->ast, definition_name);
 
             if(existing){
                 meta_expr_free_fully(existing->value);
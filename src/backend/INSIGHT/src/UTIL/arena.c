@@ -0,0 +1,98 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "UTIL/arena.h"
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_FIRST_CHUNK_SIZE (64 * 1024)
+#define ARENA_MAX_CHUNK_SIZE (8 * 1024 * 1024)
+
+void arena_init(arena_t *arena){
+    arena->chunk = NULL;
+    arena->cursor = NULL;
+    arena->next_chunk_size = ARENA_FIRST_CHUNK_SIZE;
+}
+
+void arena_free(arena_t *arena){
+    arena_chunk_t *chunk = arena->chunk;
+
+    while(chunk){
+        arena_chunk_t *prev = chunk->prev;
+        free(chunk);
+        chunk = prev;
+    }
+
+    arena->chunk = NULL;
+    arena->cursor = NULL;
+}
+
+void arena_reset(arena_t *arena){
+    arena_chunk_t *chunk = arena->chunk;
+    if(chunk == NULL) return;
+
+    if(chunk->prev){
+        size_t total_size = 0;
+
+        while(chunk){
+            arena_chunk_t *prev = chunk->prev;
+            total_size += chunk->end - (char*) chunk;
+            free(chunk);
+            chunk = prev;
+        }
+
+        chunk = malloc(total_size);
+
+        if(chunk == NULL){
+            arena->chunk = NULL;
+            arena->cursor = NULL;
+            return;
+        }
+
+        chunk->prev = NULL;
+        chunk->end = (char*) chunk + total_size;
+        arena->chunk = chunk;
+    }
+
+    arena->cursor = (char*) (chunk + 1);
+}
+
+static char *arena_align(char *cursor){
+    uintptr_t address = (uintptr_t) cursor;
+    address = (address + ARENA_ALIGNMENT - 1) & ~(uintptr_t) (ARENA_ALIGNMENT - 1);
+    return (char*) address;
+}
+
+void *arena_alloc(arena_t *arena, size_t size){
+    char *memory = arena->cursor ? arena_align(arena->cursor) : NULL;
+
+    if(memory == NULL || memory + size > arena->chunk->end){
+        size_t needed = sizeof(arena_chunk_t) + ARENA_ALIGNMENT + size;
+        size_t chunk_size = arena->next_chunk_size;
+
+        while(chunk_size < needed) chunk_size *= 2;
+
+        if(arena->next_chunk_size < ARENA_MAX_CHUNK_SIZE){
+            arena->next_chunk_size *= 2;
+        }
+
+        arena_chunk_t *chunk = malloc(chunk_size);
+        if(chunk == NULL) return NULL;
+
+        chunk->prev = arena->chunk;
+        chunk->end = (char*) chunk + chunk_size;
+        arena->chunk = chunk;
+
+        memory = arena_align((char*) (chunk + 1));
+    }
+
+    arena->cursor = memory + size;
+    return memory;
+}
+
+void *arena_memclone(arena_t *arena, const void *memory, size_t size){
+    void *clone = arena_alloc(arena, size);
+    if(clone) memcpy(clone, memory, size);
+    return clone;
+}
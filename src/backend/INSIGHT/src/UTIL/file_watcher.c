@@ -0,0 +1,179 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "UTIL/file_watcher.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+#define file_change_list_append(LIST, VALUE) list_append((LIST), (VALUE), file_change_t)
+
+// ---------------- watched_directory_t ----------------
+// A directory that has been asked to be watched
+typedef struct {
+    strong_cstr_t path; // Includes trailing slash
+    int descriptor;     // -1 when not currently being watched
+    bool unwatchable;
+} watched_directory_t;
+
+static watched_directory_t *directories = NULL;
+static length_t directories_length = 0;
+static length_t directories_capacity = 0;
+static name_index_t directories_index;
+
+static file_change_list_t pending = {0};
+
+#if defined(__linux__)
+static int watcher_fd = -1;
+static bool watcher_failed = false;
+
+#define FILE_WATCHER_EVENTS (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+#endif
+
+static watched_directory_t *file_watcher_directory(strong_cstr_t path){
+    // Finds or creates the record for a directory
+    // NOTE: Takes ownership of 'path'
+
+    if(directories == NULL){
+        name_index_init(&directories_index);
+    } else {
+        length_t existing = name_index_find(&directories_index, path);
+
+        if(existing != NAME_INDEX_NONE){
+            free(path);
+            return &directories[existing];
+        }
+    }
+
+    expand((void**) &directories, sizeof(watched_directory_t), directories_length, &directories_capacity, 1, 16);
+
+    watched_directory_t *directory = &directories[directories_length++];
+    directory->path = path;
+    directory->descriptor = -1;
+    directory->unwatchable = false;
+
+    // NOTE: Paths are never moved, so they can be borrowed by the index
+    name_index_add(&directories_index, path);
+    return directory;
+}
+
+bool file_watcher_watch(weak_cstr_t filename){
+    #if defined(__linux__)
+    if(watcher_failed) return false;
+
+    strong_cstr_t path = filename_path(filename);
+
+    if(path[0] == '\0'){
+        free(path);
+        path = strclone("./");
+    }
+
+    watched_directory_t *directory = file_watcher_directory(path);
+
+    if(directory->descriptor == -1 && !directory->unwatchable){
+        if(watcher_fd == -1){
+            watcher_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+            if(watcher_fd == -1){
+                watcher_failed = true;
+                return false;
+            }
+        }
+
+        directory->descriptor = inotify_add_watch(watcher_fd, directory->path, FILE_WATCHER_EVENTS);
+        directory->unwatchable = directory->descriptor == -1;
+    }
+
+    return directory->descriptor != -1;
+    #else
+    (void) filename;
+    return false;
+    #endif
+}
+
+void file_watcher_notify(maybe_null_weak_cstr_t filename, bool existence){
+    file_change_list_append(&pending, ((file_change_t){
+        .filename = filename ? strclone(filename) : NULL,
+        .existence = existence,
+        .is_unsaved = false,
+    }));
+}
+
+void file_watcher_notify_unsaved(weak_cstr_t filename){
+    file_change_list_append(&pending, ((file_change_t){
+        .filename = strclone(filename),
+        .existence = false,
+        .is_unsaved = true,
+    }));
+}
+
+#if defined(__linux__)
+static void file_watcher_read_events(void){
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    for(;;){
+        ssize_t length = read(watcher_fd, buffer, sizeof buffer);
+        if(length <= 0) return;
+
+        for(char *cursor = buffer; cursor < buffer + length; cursor += sizeof(struct inotify_event) + ((struct inotify_event*) cursor)->len){
+            const struct inotify_event *event = (const struct inotify_event*) cursor;
+
+            if(event->mask & IN_Q_OVERFLOW){
+                file_watcher_notify(NULL, true);
+                continue;
+            }
+
+            watched_directory_t *directory = NULL;
+
+            for(length_t i = 0; i != directories_length; i++){
+                if(directories[i].descriptor == event->wd){
+                    directory = &directories[i];
+                    break;
+                }
+            }
+
+            if(directory == NULL) continue;
+
+            if(event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)){
+                // The directory itself went away, so watch it again next time it's needed
+                if(event->mask & IN_IGNORED) directory->descriptor = -1;
+                file_watcher_notify(NULL, true);
+                continue;
+            }
+
+            if(event->len == 0) continue;
+
+            strong_cstr_t changed = mallocandsprintf("%s%s", directory->path, event->name);
+            file_watcher_notify(changed, (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) != 0);
+            free(changed);
+        }
+    }
+}
+#endif
+
+file_change_list_t file_watcher_poll(void){
+    #if defined(__linux__)
+    if(watcher_fd != -1) file_watcher_read_events();
+    #endif
+
+    file_change_list_t changes = pending;
+    pending = (file_change_list_t){0};
+    return changes;
+}
+
+void file_change_list_free(file_change_list_t *list){
+    for(length_t i = 0; i != list->length; i++){
+        free(list->changes[i].filename);
+    }
+
+    free(list->changes);
+}
@@ -24,6 +24,7 @@
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
+#include "UTIL/util.h"
 
 strong_cstr_t filename_name(const char *filename){
     length_t i;
@@ -211,6 +212,26 @@ strong_cstr_t filename_absolute(const char *filename){
     #endif
 }
 
+maybe_null_strong_cstr_t filename_absolute_maybe_missing(const char *filename){
+    #if defined(__EMSCRIPTEN__) || defined(_WIN32) || defined(_WIN64)
+        // Neither of these require the file to exist
+        return filename_absolute(filename);
+    #else
+        strong_cstr_t buffer = realpath(filename, NULL);
+        if(buffer) return buffer;
+
+        strong_cstr_t path = filename_path(filename);
+        strong_cstr_t folder = realpath(path[0] == '\0' ? "." : path, NULL);
+        free(path);
+
+        if(folder == NULL) return NULL;
+
+        buffer = mallocandsprintf("%s/%s", folder, filename_name_const((weak_cstr_t) filename));
+        free(folder);
+        return buffer;
+    #endif
+}
+
 void filename_auto_ext(strong_cstr_t *out_filename, unsigned int cross_compile_for, unsigned int mode, bool is_shared_library){
     if(mode == FILENAME_AUTO_PACKAGE){
         filename_append_if_missing(out_filename, ".dep");
@@ -33,3 +33,15 @@ hash_t hash_combine(hash_t h1, hash_t h2){
     }
     return hash;
 }
+
+text_version_t text_version(hash_t hash, length_t length){
+    return (text_version_t){
+        .hash = hash,
+        .length = length,
+        .is_known = true,
+    };
+}
+
+bool text_version_is_current(const text_version_t *cached, text_version_t current){
+    return cached->is_known && cached->hash == current.hash && cached->length == current.length;
+}
@@ -0,0 +1,93 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/name_index.h"
+#include "UTIL/util.h"
+
+#define NAME_INDEX_INITIAL_BUCKETS 16
+
+void name_index_init(name_index_t *index){
+    index->buckets = NULL;
+    index->buckets_capacity = 0;
+    index->buckets_used = 0;
+    index->next = NULL;
+    index->length = 0;
+    index->capacity = 0;
+}
+
+void name_index_free(name_index_t *index){
+    free(index->buckets);
+    free(index->next);
+}
+
+static name_index_bucket_t *name_index_bucket(name_index_bucket_t *buckets, length_t capacity, const char *name, hash_t hash){
+    // Finds the bucket for a name, or the unused bucket where it belongs
+    // NOTE: Capacity is always a power of two
+    length_t slot = hash & (capacity - 1);
+
+    while(buckets[slot].name && (buckets[slot].hash != hash || !streq(buckets[slot].name, name))){
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    return &buckets[slot];
+}
+
+static void name_index_grow(name_index_t *index){
+    length_t new_capacity = index->buckets_capacity ? index->buckets_capacity * 2 : NAME_INDEX_INITIAL_BUCKETS;
+    name_index_bucket_t *new_buckets = calloc(new_capacity, sizeof(name_index_bucket_t));
+
+    for(length_t i = 0; i != index->buckets_capacity; i++){
+        name_index_bucket_t *bucket = &index->buckets[i];
+        if(bucket->name == NULL) continue;
+
+        *name_index_bucket(new_buckets, new_capacity, bucket->name, bucket->hash) = *bucket;
+    }
+
+    free(index->buckets);
+    index->buckets = new_buckets;
+    index->buckets_capacity = new_capacity;
+}
+
+void name_index_add(name_index_t *index, maybe_null_weak_cstr_t name){
+    length_t item = index->length;
+
+    expand((void**) &index->next, sizeof(length_t), index->length, &index->capacity, 1, 16);
+    index->next[index->length++] = NAME_INDEX_NONE;
+
+    if(name == NULL) return;
+
+    // Keep load factor under 3/4
+    if((index->buckets_used + 1) * 4 > index->buckets_capacity * 3){
+        name_index_grow(index);
+    }
+
+    hash_t hash = hash_string(name);
+    name_index_bucket_t *bucket = name_index_bucket(index->buckets, index->buckets_capacity, name, hash);
+
+    if(bucket->name == NULL){
+        *bucket = (name_index_bucket_t){
+            .name = name,
+            .hash = hash,
+            .first = item,
+            .last = item,
+        };
+        index->buckets_used++;
+    } else {
+        index->next[bucket->last] = item;
+        bucket->last = item;
+    }
+}
+
+length_t name_index_find(const name_index_t *index, const char *name){
+    if(index->buckets_used == 0) return NAME_INDEX_NONE;
+
+    name_index_bucket_t *bucket = name_index_bucket(index->buckets, index->buckets_capacity, name, hash_string(name));
+    return bucket->name ? bucket->first : NAME_INDEX_NONE;
+}
+
+length_t name_index_next(const name_index_t *index, length_t item){
+    return index->next[item];
+}
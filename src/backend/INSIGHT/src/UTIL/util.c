@@ -8,6 +8,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+
+#if !__EMSCRIPTEN__ && !defined(_WIN32) && !defined(_WIN64)
+#define FILE_TEXT_MAP_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -144,12 +152,8 @@ bool file_exists(weak_cstr_t filename){
     #if __EMSCRIPTEN__
     return node_fs_existsSync(filename) != 0;
     #else
-    FILE *f = fopen(filename, "r");
-    if(f != NULL){
-        fclose(f);
-        return true;
-    }
-    return false;
+    struct stat info;
+    return stat(filename, &info) == 0 && !S_ISDIR(info.st_mode);
     #endif
 }
 
@@ -185,6 +189,74 @@ bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, lengt
     return true;
 }
 
+#ifdef FILE_TEXT_MAP_SUPPORTED
+static size_t file_text_map_size(length_t length){
+    // Size of the mapping for contents of 'length' characters (including the appended newline),
+    // which always has room for the null termination
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    return (length + 1 + page_size - 1) / page_size * page_size;
+}
+#endif
+
+bool file_text_map(weak_cstr_t filename, const char **out_contents, length_t *out_length){
+    #ifdef FILE_TEXT_MAP_SUPPORTED
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if(fd == -1) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)){
+        close(fd);
+        return false;
+    }
+
+    size_t file_size = info.st_size;
+    size_t size = file_text_map_size(file_size + 1);
+
+    // Reserve zeroed memory for the whole mapping, so that when the file
+    // ends exactly on a page boundary, the newline and null termination
+    // go into an extra zero page that follows it
+    char *buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(buffer == MAP_FAILED){
+        close(fd);
+        return false;
+    }
+
+    // Map the file over the start of the reserved memory
+    // NOTE: The rest of the final partial page of the file reads as zeros
+    if(file_size != 0 && mmap(buffer, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED){
+        munmap(buffer, size);
+        close(fd);
+        return false;
+    }
+
+    close(fd);
+
+    // Only the page that receives the newline is copied
+    buffer[file_size] = '\n';
+
+    if(mprotect(buffer, size, PROT_READ) != 0){
+        munmap(buffer, size);
+        return false;
+    }
+
+    *out_contents = buffer;
+    *out_length = file_size + 1;
+    return true;
+    #else
+    return file_text_contents(filename, (strong_cstr_t*) out_contents, out_length, true);
+    #endif
+}
+
+void file_text_unmap(const char *contents, length_t length){
+    #ifdef FILE_TEXT_MAP_SUPPORTED
+    munmap((void*) contents, file_text_map_size(length));
+    #else
+    (void) length;
+    free((void*) contents);
+    #endif
+}
+
 bool file_binary_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length){
     char *buffer;
     length_t buffer_size;
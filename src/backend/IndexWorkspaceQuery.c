@@ -0,0 +1,22 @@
+#include "IndexWorkspaceQuery.h"
+#include "symbol_index.h"
+#include "workspace_index.h"
+
+#include "UTIL/__insight_undo_overloads.h"
+
+void handle_index_workspace_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Index workspace query is missing field 'infrastructure'");
+        return;
+    }
+
+    // Declarations are found in the background, and are moved into the symbol index
+    // whenever symbols are looked up, or when this query is sent again
+    symbol_index_open(query->infrastructure);
+    workspace_index_start(&query->files);
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "indexing");
+    json_build_boolean(builder, workspace_index_collect());
+    json_build_object_end(builder);
+}
@@ -0,0 +1,262 @@
+
+#include <stdlib.h>
+
+#include "InlayHintsQuery.h"
+
+#include "compilation.h"
+#include "token_range.h"
+
+#include "AST/ast.h"
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/util.h"
+#include "UTIL/string.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Longest function name that is looked up in the AST
+#define INLAY_HINTS_MAX_WORD 256
+
+// LSP InlayHintKind.Parameter
+#define INLAY_HINT_KIND_PARAMETER 2
+
+// ---------------- inlay_hint_t ----------------
+// Name of a parameter to show before an argument
+typedef struct {
+    length_t token_index;
+    weak_cstr_t label;
+} inlay_hint_t;
+
+// ---------------- inlay_hints_t ----------------
+// List of inlay hints
+typedef struct {
+    inlay_hint_t *hints;
+    length_t length;
+    length_t capacity;
+} inlay_hints_t;
+
+static void inlay_hints_add(inlay_hints_t *hints, length_t token_index, weak_cstr_t label){
+    expand((void**) &hints->hints, sizeof(inlay_hint_t), hints->length, &hints->capacity, 1, 16);
+
+    hints->hints[hints->length++] = (inlay_hint_t){
+        .token_index = token_index,
+        .label = label,
+    };
+}
+
+static int inlay_hints_compare(const void *a, const void *b){
+    length_t a_index = ((const inlay_hint_t*) a)->token_index;
+    length_t b_index = ((const inlay_hint_t*) b)->token_index;
+    return a_index < b_index ? -1 : a_index > b_index;
+}
+
+static length_t inlay_hints_skip_newlines(tokenlist_t *tokenlist, length_t i){
+    while(i < tokenlist->length && tokenlist->tokens[i].id == TOKEN_NEWLINE) i++;
+    return i;
+}
+
+// ---------------- inlay_hints_arguments ----------------
+// Finds where each argument of a call begins, given the index of its opening '('
+// Returns the number of arguments, of which up to 'capacity' are written to 'out_arguments'
+static length_t inlay_hints_arguments(tokenlist_t *tokenlist, length_t open, length_t *out_arguments, length_t capacity){
+    token_t *tokens = tokenlist->tokens;
+    length_t count = 0;
+    length_t depth = 1;
+    length_t i = inlay_hints_skip_newlines(tokenlist, open + 1);
+
+    if(i >= tokenlist->length || tokens[i].id == TOKEN_CLOSE) return 0;
+    if(count < capacity) out_arguments[count] = i;
+    count++;
+
+    for(; i < tokenlist->length; i++){
+        switch(tokens[i].id){
+        case TOKEN_OPEN:
+        case TOKEN_BRACKET_OPEN:
+        case TOKEN_BEGIN:
+            depth++;
+            break;
+        case TOKEN_CLOSE:
+        case TOKEN_BRACKET_CLOSE:
+        case TOKEN_END:
+            if(--depth == 0) return count;
+            break;
+        case TOKEN_NEXT:
+            if(depth == 1){
+                length_t argument = inlay_hints_skip_newlines(tokenlist, i + 1);
+                if(count < capacity) out_arguments[count] = argument;
+                count++;
+            }
+            break;
+        }
+    }
+
+    // Unterminated calls are still hinted for the arguments that exist so far
+    return count;
+}
+
+static ast_func_t *inlay_hints_find_callee(ast_t *ast, weak_cstr_t name, length_t arity){
+    func_id_t func_id = ast_find_func(ast, name);
+
+    while(func_id != INVALID_FUNC_ID){
+        ast_func_t *func = &ast->funcs[func_id];
+
+        if(func->arity == arity) return func;
+        if(func->traits & (AST_FUNC_VARARG | AST_FUNC_VARIADIC) && func->arity <= arity) return func;
+
+        func_id = ast_find_next_func(ast, func_id);
+    }
+
+    return NULL;
+}
+
+static void inlay_hints_for_call(ast_t *ast, object_t *object, length_t name_index, length_t end_index, inlay_hints_t *hints){
+    tokenlist_t *tokenlist = &object->tokenlist;
+    token_t *tokens = tokenlist->tokens;
+
+    char name[INLAY_HINTS_MAX_WORD];
+    if(!token_range_word(tokenlist, object->buffer, name_index, name, INLAY_HINTS_MAX_WORD)) return;
+
+    length_t arguments[256];
+    length_t count = inlay_hints_arguments(tokenlist, name_index + 1, arguments, sizeof arguments / sizeof arguments[0]);
+    if(count == 0) return;
+
+    // Methods take the subject as their first argument
+    bool is_method_call = name_index != 0 && tokens[name_index - 1].id == TOKEN_MEMBER;
+    length_t skip = is_method_call ? 1 : 0;
+
+    ast_func_t *func = inlay_hints_find_callee(ast, name, count + skip);
+    if(func == NULL) return;
+
+    for(length_t i = 0; i != count && i < sizeof arguments / sizeof arguments[0] && i + skip < func->arity; i++){
+        length_t argument = arguments[i];
+        weak_cstr_t arg_name = func->arg_names[i + skip];
+
+        if(argument >= end_index || arg_name == NULL) continue;
+
+        // Arguments that are already named the same as the parameter don't need a hint
+        bool is_call = argument + 1 < tokenlist->length && tokens[argument + 1].id == TOKEN_OPEN;
+
+        if(tokens[argument].id == TOKEN_WORD && !is_call){
+            char word[INLAY_HINTS_MAX_WORD];
+            if(token_range_word(tokenlist, object->buffer, argument, word, INLAY_HINTS_MAX_WORD) && streq(word, arg_name)) continue;
+        }
+
+        inlay_hints_add(hints, argument, arg_name);
+    }
+}
+
+static void inlay_hints_find(ast_t *ast, object_t *object, token_range_t range, inlay_hints_t *hints){
+    token_t *tokens = object->tokenlist.tokens;
+
+    for(length_t i = range.begin; i != range.end; i++){
+        if(tokens[i].id != TOKEN_WORD || i + 1 >= object->tokenlist.length || tokens[i + 1].id != TOKEN_OPEN) continue;
+
+        // Declarations aren't calls
+        if(i != 0 && (tokens[i - 1].id == TOKEN_FUNC || tokens[i - 1].id == TOKEN_FOREIGN)) continue;
+
+        inlay_hints_for_call(ast, object, i, range.end, hints);
+    }
+}
+
+static void inlay_hints_build(json_builder_t *builder, object_t *object, length_t start_line, length_t start_line_begin, inlay_hints_t *hints){
+    qsort(hints->hints, hints->length, sizeof(inlay_hint_t), inlay_hints_compare);
+
+    // Lines only have to be counted since the previous hint
+    length_t line_begin = start_line_begin;
+    length_t scanned = line_begin;
+    length_t line = start_line;
+
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != hints->length; i++){
+        inlay_hint_t *hint = &hints->hints[i];
+        length_t index = object->tokenlist.sources[hint->token_index].index;
+
+        for(; scanned < index; scanned++){
+            if(object->buffer[scanned] == '\n'){
+                line++;
+                line_begin = scanned + 1;
+            }
+        }
+
+        strong_cstr_t label = mallocandsprintf("%s:", hint->label);
+
+        if(i != 0) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, "position");
+        json_build_object_start(builder);
+        json_build_object_key(builder, "line");
+        json_build_integer(builder, line);
+        json_build_next(builder);
+        json_build_object_key(builder, "character");
+        json_build_integer(builder, index - line_begin);
+        json_build_object_end(builder);
+        json_build_next(builder);
+        json_build_object_key(builder, "label");
+        json_build_string(builder, label);
+        json_build_next(builder);
+        json_build_object_key(builder, "kind");
+        json_build_integer(builder, INLAY_HINT_KIND_PARAMETER);
+        json_build_next(builder);
+        json_build_object_key(builder, "paddingRight");
+        json_build_boolean(builder, true);
+        json_build_object_end(builder);
+
+        free(label);
+    }
+
+    json_build_array_end(builder);
+}
+
+void handle_inlay_hints_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Inlay hints query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Inlay hints query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Inlay hints query is missing field 'code'");
+        return;
+    }
+
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex(&compilation, query);
+
+    if(lex_errorcode || compilation.tokens == NULL){
+        compilation_finish(&compilation);
+        json_build_array_start(builder);
+        json_build_array_end(builder);
+        return;
+    }
+
+    compilation_parse(&compilation);
+
+    object_t *root = compilation.root;
+    object_t *object = compilation.tokens;
+
+    if(root->compilation_stage != COMPILATION_STAGE_AST){
+        compilation_finish(&compilation);
+        json_build_array_start(builder);
+        json_build_array_end(builder);
+        return;
+    }
+
+    // Without a range, the whole file is hinted
+    length_t start_line = query->has_range ? query->range_start_line : 0;
+    length_t start_line_begin = 0;
+    token_range_t range = query->has_range
+        ? token_range_between(&object->tokenlist, object->buffer, object->buffer_length,
+            query->range_start_line, query->range_start_character, query->range_end_line, query->range_end_character, &start_line_begin)
+        : (token_range_t){0, object->tokenlist.length};
+
+    inlay_hints_t hints = {0};
+    inlay_hints_find(&root->ast, object, range, &hints);
+    inlay_hints_build(builder, object, start_line, start_line_begin, &hints);
+    free(hints.hints);
+
+    compilation_finish(&compilation);
+}
@@ -0,0 +1,66 @@
+
+#include <stdlib.h>
+
+#include "ReferencesQuery.h"
+
+#include "DRVR/reference_index.h"
+#include "UTIL/filename.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+static void build_reference_position(json_builder_t *builder, length_t line, length_t character){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, character);
+    json_build_object_end(builder);
+}
+
+void handle_references_query(query_t *query, json_builder_t *builder){
+    if(query->name == NULL){
+        json_build_string(builder, "References query is missing field 'name'");
+        return;
+    }
+
+    // References are looked up in the index of every file that has been lexed,
+    // or only in the given file when there is one
+    maybe_null_strong_cstr_t absolute = query->filename ? filename_absolute(query->filename) : NULL;
+
+    if(query->filename && absolute == NULL){
+        json_build_array_start(builder);
+        json_build_array_end(builder);
+        return;
+    }
+
+    reference_list_t references = reference_index_find(query->name, absolute);
+    free(absolute);
+
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != references.length; i++){
+        reference_t *reference = &references.references[i];
+
+        if(i != 0) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, "filename");
+        json_build_string(builder, reference->absolute);
+        json_build_next(builder);
+        json_build_object_key(builder, "range");
+        json_build_object_start(builder);
+        json_build_object_key(builder, "start");
+        build_reference_position(builder, reference->line, reference->character);
+        json_build_next(builder);
+        json_build_object_key(builder, "end");
+        build_reference_position(builder, reference->line, reference->character + reference->stride);
+        json_build_object_end(builder);
+        json_build_next(builder);
+        json_build_object_key(builder, "declaration");
+        json_build_boolean(builder, reference->is_declaration);
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+    reference_list_free(&references);
+}
@@ -0,0 +1,400 @@
+
+#include <stdio.h>
+
+#include "SemanticTokensQuery.h"
+
+#include "compilation.h"
+#include "token_range.h"
+
+#include "AST/ast.h"
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/builtin_type.h"
+#include "UTIL/name_index.h"
+#include "UTIL/util.h"
+#include "UTIL/string.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Longest identifier that is looked up in the AST
+#define SEMANTIC_TOKENS_MAX_WORD 256
+
+// ---------------- semantic_tokens_t ----------------
+// Semantic tokens in the relative encoding used by the language server protocol,
+// five integers per token
+typedef struct {
+    unsigned int *data;
+    length_t length;
+    length_t capacity;
+} semantic_tokens_t;
+
+// ---------------- semantic_tokens_result_t ----------------
+// The previous semantic tokens given for a file
+typedef struct {
+    strong_cstr_t filename;
+    length_t result_id;
+    semantic_tokens_t tokens;
+} semantic_tokens_result_t;
+
+static semantic_tokens_result_t *results = NULL;
+static length_t results_length = 0;
+static length_t results_capacity = 0;
+static length_t next_result_id = 1;
+
+// ---------------- semantic_tokens_ctx_t ----------------
+// State for classifying and encoding the tokens of a file
+typedef struct {
+    ast_t *ast;
+    name_index_t other_types; // Aliases followed by enums
+    tokenlist_t *tokenlist;
+    const char *buffer;
+
+    // Position of the previous token
+    length_t previous_line;
+    length_t previous_character;
+
+    // Position that has been scanned up to
+    length_t scanned;
+    length_t line;
+    length_t line_begin;
+} semantic_tokens_ctx_t;
+
+static semantic_tokens_result_t *semantic_tokens_find_result(weak_cstr_t filename){
+    for(length_t i = 0; i != results_length; i++){
+        if(streq(results[i].filename, filename)) return &results[i];
+    }
+    return NULL;
+}
+
+static semantic_tokens_result_t *semantic_tokens_result_for(weak_cstr_t filename){
+    semantic_tokens_result_t *result = semantic_tokens_find_result(filename);
+    if(result) return result;
+
+    expand((void**) &results, sizeof(semantic_tokens_result_t), results_length, &results_capacity, 1, 4);
+    result = &results[results_length++];
+
+    *result = (semantic_tokens_result_t){
+        .filename = strclone(filename),
+        .result_id = next_result_id++,
+    };
+    return result;
+}
+
+void semantic_tokens_forget(weak_cstr_t filename){
+    semantic_tokens_result_t *result = semantic_tokens_find_result(filename);
+    if(result == NULL) return;
+
+    free(result->filename);
+    free(result->tokens.data);
+    *result = results[--results_length];
+}
+
+static void semantic_tokens_ctx_init(semantic_tokens_ctx_t *ctx, ast_t *ast, object_t *object){
+    ctx->ast = ast;
+    ctx->tokenlist = &object->tokenlist;
+    ctx->buffer = object->buffer;
+    ctx->previous_line = 0;
+    ctx->previous_character = 0;
+    ctx->scanned = 0;
+    ctx->line = 0;
+    ctx->line_begin = 0;
+
+    // Aliases and enums aren't indexed by the AST
+    name_index_init(&ctx->other_types);
+
+    if(ast){
+        for(length_t i = 0; i != ast->aliases_length; i++){
+            name_index_add(&ctx->other_types, ast->aliases[i].name);
+        }
+
+        for(length_t i = 0; i != ast->enums_length; i++){
+            name_index_add(&ctx->other_types, ast->enums[i].name);
+        }
+    }
+}
+
+static void semantic_tokens_ctx_free(semantic_tokens_ctx_t *ctx){
+    name_index_free(&ctx->other_types);
+}
+
+static semantic_token_type_t semantic_tokens_classify_word(semantic_tokens_ctx_t *ctx, length_t i){
+    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t previous = i != 0 ? tokens[i - 1].id : TOKEN_NONE;
+    tokenid_t next = i + 1 < ctx->tokenlist->length ? tokens[i + 1].id : TOKEN_NONE;
+
+    if(previous == TOKEN_ASSOCIATE) return SEMANTIC_TOKEN_ENUM_MEMBER;
+    if(next == TOKEN_ASSOCIATE) return SEMANTIC_TOKEN_TYPE;
+    if(previous == TOKEN_FUNC) return SEMANTIC_TOKEN_FUNCTION;
+
+    char word[SEMANTIC_TOKENS_MAX_WORD];
+    if(!token_range_word(ctx->tokenlist, ctx->buffer, i, word, SEMANTIC_TOKENS_MAX_WORD)) return SEMANTIC_TOKEN_NONE;
+
+    if(typename_is_extended_builtin_type(word)) return SEMANTIC_TOKEN_TYPE;
+
+    ast_t *ast = ctx->ast;
+    if(ast == NULL) return SEMANTIC_TOKEN_NONE;
+
+    if(name_index_find(&ast->composites_index, word) != NAME_INDEX_NONE
+    || name_index_find(&ast->poly_composites_index, word) != NAME_INDEX_NONE
+    || name_index_find(&ctx->other_types, word) != NAME_INDEX_NONE){
+        return SEMANTIC_TOKEN_TYPE;
+    }
+
+    if(ast_find_func(ast, word) != INVALID_FUNC_ID) return SEMANTIC_TOKEN_FUNCTION;
+    return SEMANTIC_TOKEN_NONE;
+}
+
+static semantic_token_type_t semantic_tokens_classify(semantic_tokens_ctx_t *ctx, length_t i){
+    tokenid_t id = ctx->tokenlist->tokens[i].id;
+
+    if(id >= BEGINNING_OF_KEYWORD_TOKENS && id <= MAX_LEX_TOKEN) return SEMANTIC_TOKEN_KEYWORD;
+
+    switch(id){
+    case TOKEN_WORD:
+        return semantic_tokens_classify_word(ctx, i);
+    case TOKEN_STRING:
+    case TOKEN_CSTRING:
+        return SEMANTIC_TOKEN_STRING;
+    case TOKEN_BYTE: case TOKEN_UBYTE: case TOKEN_SHORT: case TOKEN_USHORT:
+    case TOKEN_INT: case TOKEN_UINT: case TOKEN_LONG: case TOKEN_ULONG:
+    case TOKEN_USIZE: case TOKEN_FLOAT: case TOKEN_DOUBLE:
+    case TOKEN_GENERIC_INT: case TOKEN_GENERIC_FLOAT:
+        return SEMANTIC_TOKEN_NUMBER;
+    case TOKEN_POLYMORPH:
+    case TOKEN_POLYCOUNT:
+        return SEMANTIC_TOKEN_TYPE_PARAMETER;
+    case TOKEN_META:
+        return SEMANTIC_TOKEN_KEYWORD;
+    }
+
+    return SEMANTIC_TOKEN_NONE;
+}
+
+static void semantic_tokens_push(semantic_tokens_t *tokens, length_t delta_line, length_t delta_character, length_t length, semantic_token_type_t type){
+    if(tokens->length + 5 > tokens->capacity){
+        expand((void**) &tokens->data, sizeof(unsigned int), tokens->length, &tokens->capacity, 5, 1280);
+    }
+
+    unsigned int *token = &tokens->data[tokens->length];
+    token[0] = delta_line;
+    token[1] = delta_character;
+    token[2] = length;
+    token[3] = type;
+    token[4] = 0;
+    tokens->length += 5;
+}
+
+static void semantic_tokens_encode(semantic_tokens_ctx_t *ctx, length_t i, semantic_token_type_t type, semantic_tokens_t *out_tokens){
+    source_t source = ctx->tokenlist->sources[i];
+    const char *text = &ctx->buffer[source.index];
+
+    // Tokens that span multiple lines can't be represented
+    if(source.stride == 0 || memchr(text, '\n', source.stride)) return;
+
+    // Lines only have to be counted since the previous token
+    for(length_t j = ctx->scanned; j != source.index; j++){
+        if(ctx->buffer[j] == '\n'){
+            ctx->line++;
+            ctx->line_begin = j + 1;
+        }
+    }
+
+    ctx->scanned = source.index;
+
+    length_t character = source.index - ctx->line_begin;
+    length_t delta_line = ctx->line - ctx->previous_line;
+    length_t delta_character = delta_line == 0 ? character - ctx->previous_character : character;
+
+    semantic_tokens_push(out_tokens, delta_line, delta_character, source.stride, type);
+    ctx->previous_line = ctx->line;
+    ctx->previous_character = character;
+}
+
+static void semantic_tokens_build(semantic_tokens_ctx_t *ctx, token_range_t range, semantic_tokens_t *out_tokens){
+    for(length_t i = range.begin; i != range.end; i++){
+        semantic_token_type_t type = semantic_tokens_classify(ctx, i);
+        if(type != SEMANTIC_TOKEN_NONE) semantic_tokens_encode(ctx, i, type, out_tokens);
+    }
+}
+
+static void semantic_tokens_build_data(json_builder_t *builder, const unsigned int *data, length_t length){
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != length; i++){
+        if(i != 0) json_build_next(builder);
+        json_build_integer(builder, data[i]);
+    }
+
+    json_build_array_end(builder);
+}
+
+static void semantic_tokens_result_id_string(length_t result_id, char out_string[static 32]){
+    snprintf(out_string, 32, "%zu", (size_t) result_id);
+}
+
+static void semantic_tokens_build_result_id(json_builder_t *builder, length_t result_id){
+    char string[32];
+    semantic_tokens_result_id_string(result_id, string);
+
+    json_build_object_key(builder, "resultId");
+    json_build_string(builder, string);
+}
+
+static void semantic_tokens_build_response(json_builder_t *builder, semantic_tokens_result_t *result, semantic_tokens_t *previous){
+    json_build_object_start(builder);
+    semantic_tokens_build_result_id(builder, result->result_id);
+    json_build_next(builder);
+
+    semantic_tokens_t *tokens = &result->tokens;
+
+    if(previous == NULL){
+        json_build_object_key(builder, "data");
+        semantic_tokens_build_data(builder, tokens->data, tokens->length);
+        json_build_object_end(builder);
+        return;
+    }
+
+    // Only the range of integers that differs from the previous result is given
+    length_t min_length = previous->length < tokens->length ? previous->length : tokens->length;
+    length_t prefix = 0;
+    length_t suffix = 0;
+
+    while(prefix != min_length && previous->data[prefix] == tokens->data[prefix]) prefix++;
+
+    while(suffix != min_length - prefix
+    && previous->data[previous->length - suffix - 1] == tokens->data[tokens->length - suffix - 1]){
+        suffix++;
+    }
+
+    json_build_object_key(builder, "edits");
+    json_build_array_start(builder);
+
+    if(prefix != previous->length || previous->length != tokens->length){
+        json_build_object_start(builder);
+        json_build_object_key(builder, "start");
+        json_build_integer(builder, prefix);
+        json_build_next(builder);
+        json_build_object_key(builder, "deleteCount");
+        json_build_integer(builder, previous->length - prefix - suffix);
+        json_build_next(builder);
+        json_build_object_key(builder, "data");
+        semantic_tokens_build_data(builder, &tokens->data[prefix], tokens->length - prefix - suffix);
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+    json_build_object_end(builder);
+}
+
+static void handle_semantic_tokens_range_query(query_t *query, json_builder_t *builder){
+    // Only the tokens within the range are classified, and the result isn't
+    // kept since it can't be used for later deltas
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex(&compilation, query);
+
+    if(lex_errorcode || compilation.tokens == NULL){
+        compilation_finish(&compilation);
+
+        json_build_object_start(builder);
+        json_build_object_key(builder, "data");
+        json_build_array_start(builder);
+        json_build_array_end(builder);
+        json_build_object_end(builder);
+        return;
+    }
+
+    compilation_parse(&compilation);
+
+    object_t *root = compilation.root;
+    object_t *object = compilation.tokens;
+    ast_t *ast = root->compilation_stage == COMPILATION_STAGE_AST ? &root->ast : NULL;
+
+    semantic_tokens_t tokens = {0};
+    semantic_tokens_ctx_t ctx;
+    semantic_tokens_ctx_init(&ctx, ast, object);
+
+    // Lines are counted from the beginning of the range instead of the beginning of the file
+    token_range_t range = token_range_between(&object->tokenlist, object->buffer, object->buffer_length,
+        query->range_start_line, query->range_start_character, query->range_end_line, query->range_end_character, &ctx.line_begin);
+
+    ctx.scanned = ctx.line_begin;
+    ctx.line = query->range_start_line;
+
+    semantic_tokens_build(&ctx, range, &tokens);
+    semantic_tokens_ctx_free(&ctx);
+
+    compilation_finish(&compilation);
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "data");
+    semantic_tokens_build_data(builder, tokens.data, tokens.length);
+    json_build_object_end(builder);
+
+    free(tokens.data);
+}
+
+static bool semantic_tokens_is_result(semantic_tokens_result_t *result, maybe_null_weak_cstr_t result_id){
+    if(result == NULL || result_id == NULL) return false;
+
+    char expected[32];
+    semantic_tokens_result_id_string(result->result_id, expected);
+    return streq(expected, result_id);
+}
+
+void handle_semantic_tokens_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Semantic tokens query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Semantic tokens query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Semantic tokens query is missing field 'code'");
+        return;
+    }
+
+    if(query->has_range){
+        handle_semantic_tokens_range_query(query, builder);
+        return;
+    }
+
+    semantic_tokens_result_t *result = semantic_tokens_find_result(query->filename);
+    bool is_delta = semantic_tokens_is_result(result, query->previous_result_id);
+
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex(&compilation, query);
+
+    if(lex_errorcode || compilation.tokens == NULL){
+        // Keep the previous highlighting until the code can be lexed again
+        compilation_finish(&compilation);
+
+        result = semantic_tokens_result_for(query->filename);
+        semantic_tokens_build_response(builder, result, is_delta ? &result->tokens : NULL);
+        return;
+    }
+
+    // Symbols are classified using whatever could be parsed
+    compilation_parse(&compilation);
+
+    object_t *root = compilation.root;
+    ast_t *ast = root->compilation_stage == COMPILATION_STAGE_AST ? &root->ast : NULL;
+
+    semantic_tokens_t tokens = {0};
+    semantic_tokens_ctx_t ctx;
+    semantic_tokens_ctx_init(&ctx, ast, compilation.tokens);
+    semantic_tokens_build(&ctx, (token_range_t){0, ctx.tokenlist->length}, &tokens);
+    semantic_tokens_ctx_free(&ctx);
+
+    compilation_finish(&compilation);
+
+    result = semantic_tokens_result_for(query->filename);
+    semantic_tokens_t previous = result->tokens;
+    result->tokens = tokens;
+    result->result_id = next_result_id++;
+
+    semantic_tokens_build_response(builder, result, is_delta ? &previous : NULL);
+    free(previous.data);
+}
@@ -0,0 +1,188 @@
+
+#include <stdlib.h>
+
+#include "SignatureHelpQuery.h"
+
+#include "compilation.h"
+#include "signature_table.h"
+#include "token_range.h"
+
+#include "DRVR/object.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// ---------------- signature_help_call_t ----------------
+// The call that a caret is within
+typedef struct {
+    weak_cstr_t name;
+    length_t active_parameter;
+    bool is_method;
+} signature_help_call_t;
+
+static successful_t signature_help_find_call(tokenlist_t *tokenlist, length_t offset, signature_help_call_t *out_call){
+    token_t *tokens = tokenlist->tokens;
+    length_t depth = 0;
+    length_t active_parameter = 0;
+
+    // Walk backwards from the caret until reaching the unclosed '(' of a call
+    for(length_t i = token_range_first_at(tokenlist, offset); i != 0; i--){
+        tokenid_t id = tokens[i - 1].id;
+
+        switch(id){
+        case TOKEN_CLOSE:
+        case TOKEN_BRACKET_CLOSE:
+            depth++;
+            break;
+        case TOKEN_BRACKET_OPEN:
+            if(depth == 0) return false;
+            depth--;
+            break;
+        case TOKEN_OPEN:
+            if(depth != 0){
+                depth--;
+                break;
+            }
+
+            if(i >= 2 && tokens[i - 2].id == TOKEN_WORD){
+                tokenid_t before = i >= 3 ? tokens[i - 3].id : TOKEN_NONE;
+
+                // Declarations aren't calls
+                if(before == TOKEN_FUNC || before == TOKEN_FOREIGN) return false;
+
+                *out_call = (signature_help_call_t){
+                    .name = (weak_cstr_t) tokens[i - 2].data,
+                    .active_parameter = active_parameter,
+                    .is_method = before == TOKEN_MEMBER,
+                };
+                return true;
+            }
+
+            // The caret is within parentheses that group an argument
+            active_parameter = 0;
+            break;
+        case TOKEN_NEXT:
+            if(depth == 0) active_parameter++;
+            break;
+        case TOKEN_BEGIN:
+        case TOKEN_END:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+static void build_signature_information(json_builder_t *builder, signature_t *signature, bool skip_this){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "label");
+    json_build_string(builder, signature->label);
+    json_build_next(builder);
+    json_build_object_key(builder, "parameters");
+    json_build_array_start(builder);
+
+    for(length_t i = skip_this ? 1 : 0; i < signature->arity; i++){
+        signature_param_t *param = &signature->params[i];
+
+        if(i != (skip_this ? 1 : 0)) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, "label");
+        json_build_array_start(builder);
+        json_build_integer(builder, param->label_begin);
+        json_build_next(builder);
+        json_build_integer(builder, param->label_end);
+        json_build_array_end(builder);
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+    json_build_object_end(builder);
+}
+
+static bool signature_help_has_this(signature_t *signature){
+    return signature->arity != 0 && signature->params[0].name && streq(signature->params[0].name, "this");
+}
+
+static void build_signature_help(json_builder_t *builder, signature_list_t *overloads, signature_help_call_t *call){
+    // Prefer the first overload that can take the argument being typed
+    length_t active_signature = 0;
+
+    for(length_t i = 0; i != overloads->length; i++){
+        signature_t *signature = overloads->signatures[i];
+        length_t arity = signature->arity - (call->is_method && signature_help_has_this(signature) ? 1 : 0);
+
+        if(call->active_parameter < arity || signature->is_variadic){
+            active_signature = i;
+            break;
+        }
+    }
+
+    json_build_object_start(builder);
+    json_build_object_key(builder, "signatures");
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != overloads->length; i++){
+        signature_t *signature = overloads->signatures[i];
+
+        if(i != 0) json_build_next(builder);
+        build_signature_information(builder, signature, call->is_method && signature_help_has_this(signature));
+    }
+
+    json_build_array_end(builder);
+    json_build_next(builder);
+    json_build_object_key(builder, "activeSignature");
+    json_build_integer(builder, active_signature);
+    json_build_next(builder);
+    json_build_object_key(builder, "activeParameter");
+    json_build_integer(builder, call->active_parameter);
+    json_build_object_end(builder);
+}
+
+void handle_signature_help_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Signature help query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->filename == NULL){
+        json_build_string(builder, "Signature help query is missing field 'filename'");
+        return;
+    }
+
+    if(query->code == NULL){
+        json_build_string(builder, "Signature help query is missing field 'code'");
+        return;
+    }
+
+    if(!query->has_range){
+        json_build_string(builder, "Signature help query is missing field 'range'");
+        return;
+    }
+
+    // Only the code is lexed, since overloads come from the table of the last
+    // successful compilation, and the code is rarely complete while typing a call
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex_tokens(&compilation, query);
+
+    signature_help_call_t call = {0};
+    signature_list_t overloads = {0};
+    object_t *object = compilation.tokens;
+
+    if(lex_errorcode == SUCCESS && object){
+        length_t offset = token_range_offset(object->buffer, object->buffer_length, query->range_start_line, query->range_start_character, NULL);
+
+        if(signature_help_find_call(&object->tokenlist, offset, &call)){
+            overloads = signature_table_find(object->full_filename, call.name);
+        }
+    }
+
+    if(overloads.length != 0){
+        build_signature_help(builder, &overloads, &call);
+    } else {
+        json_build_null(builder);
+    }
+
+    free(overloads.signatures);
+    compilation_finish(&compilation);
+}
@@ -0,0 +1,100 @@
+#include <stdlib.h>
+
+#include "SymbolsQuery.h"
+#include "symbol_index.h"
+#include "workspace_index.h"
+
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Most declarations given for a search of the workspace
+#define WORKSPACE_SYMBOLS_LIMIT 128
+
+static void build_symbol_position(json_builder_t *builder, length_t line, length_t character){
+    json_build_object_start(builder);
+    json_build_object_key(builder, "line");
+    json_build_integer(builder, line);
+    json_build_next(builder);
+    json_build_object_key(builder, "character");
+    json_build_integer(builder, character);
+    json_build_object_end(builder);
+}
+
+static void build_symbols(json_builder_t *builder, symbol_list_t *symbols){
+    json_build_array_start(builder);
+
+    for(length_t i = 0; i != symbols->length; i++){
+        symbol_t *symbol = &symbols->symbols[i];
+
+        if(i != 0) json_build_next(builder);
+        json_build_object_start(builder);
+        json_build_object_key(builder, "name");
+        json_build_string(builder, symbol->name);
+        json_build_next(builder);
+        json_build_object_key(builder, "kind");
+        json_build_string(builder, symbol_kind_name(symbol->kind));
+        json_build_next(builder);
+        json_build_object_key(builder, "definition");
+        json_builder_append(builder, symbol->definition[0] != '\0' ? symbol->definition : "\"\"");
+        json_build_next(builder);
+        json_build_object_key(builder, "filename");
+        json_build_string(builder, symbol->filename);
+        json_build_next(builder);
+        json_build_object_key(builder, "range");
+        json_build_object_start(builder);
+        json_build_object_key(builder, "start");
+        build_symbol_position(builder, symbol->line, symbol->character);
+        json_build_next(builder);
+        json_build_object_key(builder, "end");
+        build_symbol_position(builder, symbol->line, symbol->character);
+        json_build_object_end(builder);
+        json_build_object_end(builder);
+    }
+
+    json_build_array_end(builder);
+}
+
+void handle_symbols_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Symbols query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->name == NULL){
+        json_build_string(builder, "Symbols query is missing field 'name'");
+        return;
+    }
+
+    // Declarations are known from the cache file of the infrastructure
+    // before any file has been compiled, and from every file compiled since
+    symbol_index_open(query->infrastructure);
+
+    // Files of the workspace that haven't been compiled yet are known as soon as they're indexed
+    workspace_index_collect();
+
+    symbol_list_t symbols = symbol_index_find(query->name, query->features & QUERY_FEATURE_MATCH_PREFIX);
+    build_symbols(builder, &symbols);
+    free(symbols.symbols);
+}
+
+void handle_workspace_symbols_query(query_t *query, json_builder_t *builder){
+    if(query->infrastructure == NULL){
+        json_build_string(builder, "Workspace symbols query is missing field 'infrastructure'");
+        return;
+    }
+
+    if(query->name == NULL){
+        json_build_string(builder, "Workspace symbols query is missing field 'name'");
+        return;
+    }
+
+    symbol_index_open(query->infrastructure);
+    workspace_index_collect();
+
+    // Only the best matches are given, since the client filters and sorts them further as more is typed
+    symbol_list_t symbols = symbol_index_search(query->name, WORKSPACE_SYMBOLS_LIMIT);
+    build_symbols(builder, &symbols);
+    free(symbols.symbols);
+}
+
+
@@ -1,6 +1,8 @@
 
 #include "ValidationQuery.h"
 
+#include "compilation.h"
+
 #include "LEX/lex.h"
 #include "DRVR/compiler.h"
 #include "PARSE/parse.h"
@@ -25,31 +27,13 @@ void handle_validation_query(query_t *query, json_builder_t *builder){
         return;
     }
 
-    compiler_t compiler;
-    compiler_init(&compiler);
-    object_t *object = compiler_new_object(&compiler);
-
-    object->filename = strclone(query->filename);
-    object->full_filename = filename_absolute(object->filename);
-    
-    // Force object->full_filename to not be NULL
-    if(object->full_filename == NULL) object->full_filename = strclone("");
+    compilation_t compilation;
+    errorcode_t lex_errorcode = compilation_lex(&compilation, query);
 
-    // Set compiler root
-    compiler.root = strclone(query->infrastructure);
-
-    if (!query->warnings) {
-        compiler.traits |= COMPILER_NO_WARN;
-        compiler.ignore |= COMPILER_IGNORE_ALL;
-    }
+    compiler_t *compiler = compilation.compiler;
 
-    // NOTE: Passing ownership of 'code' to object instance!!!
-    object->buffer = query->code;
-    object->buffer_length = strlen(query->code);
-    query->code = NULL;
-    
-    if(lex_buffer(&compiler, object))   goto store_and_cleanup;
-    if(parse(&compiler, object))        goto store_and_cleanup;
+    if(lex_errorcode)                   goto store_and_cleanup;
+    if(compilation_parse(&compilation)) goto store_and_cleanup;
 
     length_t i;
 
@@ -57,7 +41,7 @@ store_and_cleanup:
     json_build_array_start(builder);
 
     // Push warnings
-    for(i = 0; i != compiler.warnings_length; i++){
+    for(i = 0; i != compiler->warnings_length; i++){
         json_build_object_start(builder);
 
         json_build_object_key(builder, "kind");
@@ -65,17 +49,17 @@ store_and_cleanup:
         json_build_next(builder);
 
         json_build_object_key(builder, "source");
-        json_build_source(builder, &compiler, compiler.warnings[i].source);
+        json_build_source(builder, compiler, compiler->warnings[i].source);
         json_build_next(builder);
 
         json_build_object_key(builder, "message");
-        json_build_string(builder, compiler.warnings[i].message);
+        json_build_string(builder, compiler->warnings[i].message);
 
         json_build_object_end(builder);
-        if(i + 1 != compiler.warnings_length || compiler.error) json_build_next(builder);
+        if(i + 1 != compiler->warnings_length || compiler->error) json_build_next(builder);
     }
 
-    if(compiler.error){
+    if(compiler->error){
         json_build_object_start(builder);
 
         json_build_object_key(builder, "kind");
@@ -83,11 +67,11 @@ store_and_cleanup:
         json_build_next(builder);
 
         json_build_object_key(builder, "source");
-        json_build_source(builder, &compiler, compiler.error->source);
+        json_build_source(builder, compiler, compiler->error->source);
         json_build_next(builder);
 
         json_build_object_key(builder, "message");
-        json_build_string(builder, compiler.error->message);
+        json_build_string(builder, compiler->error->message);
 
         json_build_object_end(builder);
     }
@@ -95,6 +79,6 @@ store_and_cleanup:
     json_build_array_end(builder);
 
 cleanup:
-    compiler_free(&compiler);
+    compilation_finish(&compilation);
     return;
 }
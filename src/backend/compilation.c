@@ -0,0 +1,542 @@
+
+#include "compilation.h"
+#include "project.h"
+#include "symbol_index.h"
+#include "workspace_index.h"
+
+#include "AST/ast_shift.h"
+#include "DRVR/file_cache.h"
+#include "DRVR/import_cache.h"
+#include "DRVR/overlay.h"
+#include "DRVR/call_graph.h"
+#include "DRVR/reference_index.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "PARSE/parse_func.h"
+#include "UTIL/file_watcher.h"
+#include "UTIL/util.h"
+#include "UTIL/string.h"
+#include "UTIL/filename.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Number of function bodies that can be reparsed before a full parse is forced,
+// since replaced token lists are kept until the compiler is reset
+#define COMPILATION_MAX_REPARSES 64
+
+static compiler_t *cached_compiler = NULL;
+static length_t cached_reparses = 0;
+
+// Discarded compiler that keeps the memory of its arena around,
+// so that the next compilation doesn't have to grow everything from scratch
+static compiler_t *pooled_compiler = NULL;
+
+static void compilation_discard(compiler_t *compiler){
+    if(pooled_compiler == NULL){
+        compiler_reset(compiler);
+        pooled_compiler = compiler;
+        return;
+    }
+
+    compiler_free(compiler);
+    free(compiler);
+}
+
+static compiler_t *compilation_new_compiler(void){
+    compiler_t *compiler = pooled_compiler;
+
+    if(compiler){
+        pooled_compiler = NULL;
+        return compiler;
+    }
+
+    compiler = malloc(sizeof(compiler_t));
+
+    compiler_init(compiler);
+    return compiler;
+}
+
+static object_t *compilation_find_object(compiler_t *compiler, weak_cstr_t absolute){
+    for(length_t i = 0; i != compiler->objects_length; i++){
+        weak_cstr_t full_filename = compiler->objects[i]->full_filename;
+        if(full_filename && streq(full_filename, absolute)) return compiler->objects[i];
+    }
+    return NULL;
+}
+
+static bool compilation_is_stale(compiler_t *compiler, weak_cstr_t absolute){
+    // Objects that have the unsaved contents of a changed file are still up to date,
+    // which is the case for files given by queries
+    object_t *object = compilation_find_object(compiler, absolute);
+    return object && !overlay_matches(absolute, object->buffer, object->buffer_length);
+}
+
+static void compilation_apply_file_changes(void){
+    // Forgets everything that was cached about files that changed
+    file_change_list_t changes = file_watcher_poll();
+    bool discard = false;
+
+    for(length_t i = 0; i != changes.length; i++){
+        file_change_t *change = &changes.changes[i];
+
+        project_file_changed(change->filename, change->existence);
+
+        if(change->filename == NULL){
+            import_cache_clear();
+            file_cache_clear();
+            discard = true;
+            continue;
+        }
+
+        // Creating or removing a file can change which files imports resolve to
+        if(change->existence){
+            import_cache_invalidate(change->filename);
+            discard = true;
+
+            // Identifiers and functions of removed files aren't referenced anymore
+            if(!file_exists(change->filename)){
+                reference_index_forget(change->filename);
+                call_graph_forget(change->filename);
+                symbol_index_forget(change->filename);
+            }
+        }
+
+        // Files within the workspace that changed on disk are indexed again in the background
+        if(!change->is_unsaved && file_exists(change->filename)){
+            workspace_index_refresh(change->filename);
+        }
+
+        file_cache_invalidate(change->filename);
+
+        if(cached_compiler && compilation_is_stale(cached_compiler, change->filename)){
+            discard = true;
+        }
+    }
+
+    file_change_list_free(&changes);
+
+    if(discard && cached_compiler){
+        compilation_discard(cached_compiler);
+        cached_compiler = NULL;
+    }
+}
+
+static void compilation_publish_buffer(object_t *object){
+    // Other files that import this one should see its unsaved contents
+    if(object->full_filename[0] != '\0'){
+        overlay_set(object->full_filename, object->buffer, object->buffer_length);
+    }
+}
+
+static bool compilation_matches_query(compiler_t *compiler, query_t *query, weak_cstr_t root_filename){
+    object_t *root = compiler->objects[0];
+
+    return streq(compiler->root, query->infrastructure)
+        && streq(root->filename, root_filename)
+        && !(compiler->traits & COMPILER_NO_WARN) == query->warnings
+        && !(query->kind == QUERY_KIND_VALIDATE && compiler->traits & COMPILER_SKIP_IMPORTED_BODIES); // (bodies are needed to validate)
+}
+
+static successful_t compilation_match_body(tokenlist_t *tokenlist, length_t begin, length_t *out_end){
+    // Finds the closing '}' for the '{' at 'begin'
+    // Bodies that contain meta directives are rejected, since they can depend on surrounding context
+    length_t depth = 0;
+
+    if(begin >= tokenlist->length || tokenlist->tokens[begin].id != TOKEN_BEGIN) return false;
+
+    for(length_t i = begin; i != tokenlist->length; i++){
+        tokenid_t id = tokenlist->tokens[i].id;
+
+        if(id == TOKEN_META) return false;
+
+        if(id == TOKEN_BEGIN){
+            depth++;
+        } else if(id == TOKEN_END && --depth == 0){
+            *out_end = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static errorcode_t compilation_prepare_reparse(compilation_t *compilation, query_t *query){
+    compiler_t *compiler = compilation->compiler;
+    object_t *object = compilation->object;
+    ast_t *ast = &compilation->root->ast;
+
+    const char *old_buffer = object->buffer;
+    const char *new_buffer = query->code;
+    length_t old_length = object->buffer_length;
+    length_t new_length = strlen(query->code);
+    length_t min_length = old_length < new_length ? old_length : new_length;
+
+    // Find the range of text that changed
+    length_t prefix = 0;
+    while(prefix != min_length && old_buffer[prefix] == new_buffer[prefix]) prefix++;
+
+    length_t suffix = 0;
+    while(suffix != min_length - prefix && old_buffer[old_length - suffix - 1] == new_buffer[new_length - suffix - 1]) suffix++;
+
+    length_t old_edit_end = old_length - suffix;
+
+    if(prefix == old_length && old_length == new_length){
+        compilation->parse_kind = COMPILATION_PARSE_NONE;
+    } else {
+        // Find the function whose body contains the entire edit
+        tokenlist_t *old_tokenlist = &object->tokenlist;
+        func_id_t func_id = INVALID_FUNC_ID;
+
+        for(length_t i = 0; i != ast->funcs_length; i++){
+            ast_func_t *func = &ast->funcs[i];
+            if(func->source.object_index != object->index || func->body_token_index == 0) continue;
+
+            if(old_tokenlist->sources[func->body_token_index].index < prefix && func->end_source.index >= old_edit_end){
+                func_id = i;
+                break;
+            }
+        }
+
+        if(func_id == INVALID_FUNC_ID) return FAILURE;
+
+        ast_func_t *func = &ast->funcs[func_id];
+        length_t old_body_end_token;
+
+        // Constructors of classes need their class to parse calls to 'super',
+        // so ones without a remembered composite domain are parsed along with everything else
+        if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR && func->composite_association == (length_t) -1){
+            return FAILURE;
+        }
+
+        if(!compilation_match_body(old_tokenlist, func->body_token_index, &old_body_end_token)
+        || old_tokenlist->sources[old_body_end_token].index != func->end_source.index){
+            return FAILURE;
+        }
+
+        compilation->parse_kind = COMPILATION_PARSE_FUNC_BODY;
+        compilation->func_id = func_id;
+        compilation->body_begin_index = old_tokenlist->sources[func->body_token_index].index;
+        compilation->old_body_end_index = func->end_source.index;
+        compilation->new_body_end_index = func->end_source.index + new_length - old_length;
+        compilation->old_body_end_token = old_body_end_token;
+    }
+
+    // Always lex everything again, since parsing takes ownership of token data
+    object_t lexed = *object;
+    lexed.buffer = query->code;
+    lexed.buffer_length = new_length;
+
+    if(lex_buffer(compiler, &lexed)) return FAILURE;
+
+    if(compilation->parse_kind == COMPILATION_PARSE_FUNC_BODY){
+        // Ensure that the edit didn't escape the function body
+        tokenlist_t *new_tokenlist = &lexed.tokenlist;
+        length_t new_body_end_token;
+
+        if(!compilation_match_body(new_tokenlist, ast->funcs[compilation->func_id].body_token_index, &new_body_end_token)
+        || new_tokenlist->sources[new_body_end_token].index != compilation->new_body_end_index){
+            tokenlist_free(new_tokenlist);
+            return FAILURE;
+        }
+
+        compilation->new_body_end_token = new_body_end_token;
+    }
+
+    // The rest of the AST can still point into the data of the previous token list
+    expand((void**) &object->retired_tokenlists, sizeof(tokenlist_t), object->retired_tokenlists_length, &object->retired_tokenlists_capacity, 1, 4);
+    object->retired_tokenlists[object->retired_tokenlists_length++] = object->tokenlist;
+
+    if(object->traits & OBJECT_BORROWED_BUFFER){
+        file_cache_release(object->full_filename, object->buffer);
+        object->traits &= ~OBJECT_BORROWED_BUFFER;
+    } else {
+        free(object->buffer);
+    }
+
+    object->buffer = query->code;
+    object->buffer_length = new_length;
+    object->buffer_hash = lexed.buffer_hash;
+    object->tokenlist = lexed.tokenlist;
+    query->code = NULL;
+    return SUCCESS;
+}
+
+static object_t *compilation_new_root(compilation_t *compilation, query_t *query, weak_cstr_t filename){
+    compiler_t *compiler = compilation->compiler;
+    object_t *object = compiler_new_object(compiler);
+
+    object->filename = strclone(filename);
+    object->full_filename = filename_absolute(object->filename);
+
+    // Force object->full_filename to not be NULL
+    if(object->full_filename == NULL) object->full_filename = strclone("");
+
+    // Set compiler root
+    compiler->root = strclone(query->infrastructure);
+
+    // Only declarations of imported files are needed,
+    // except when validating, since errors within their bodies are reported too
+    if(query->kind != QUERY_KIND_VALIDATE){
+        compiler->traits |= COMPILER_SKIP_IMPORTED_BODIES;
+    }
+
+    if (!query->warnings) {
+        compiler->traits |= COMPILER_NO_WARN;
+        compiler->ignore |= COMPILER_IGNORE_ALL;
+    }
+
+    compilation->root = object;
+    return object;
+}
+
+static errorcode_t compilation_lex_standalone(compilation_t *compilation, query_t *query, bool publish){
+    object_t *object = compilation_new_root(compilation, query, query->filename);
+
+    // NOTE: Passing ownership of 'code' to object instance!!!
+    object->buffer = query->code;
+    object->buffer_length = strlen(query->code);
+    query->code = NULL;
+
+    compilation->object = object;
+    compilation->tokens = object;
+    if(publish) compilation_publish_buffer(object);
+    return lex_buffer(compilation->compiler, object);
+}
+
+static errorcode_t compilation_lex_project(compilation_t *compilation, query_t *query, weak_cstr_t entry){
+    compiler_t *compiler = compilation->compiler;
+    object_t *root = compilation_new_root(compilation, query, entry);
+
+    // The file of the query is read through its unsaved contents once it's imported
+    overlay_set(compilation->focus, query->code, strlen(query->code));
+
+    // Tokens of the code are still needed before the file is imported
+    compilation->object = NULL;
+    compilation->tokens = &compilation->scratch;
+    compilation->scratch = (object_t){
+        .filename = query->filename,
+        .full_filename = compilation->focus,
+        .buffer = query->code,
+        .buffer_length = strlen(query->code),
+        .index = root->index,
+    };
+
+    // Errors in the code will be reported again once the file is imported
+    if(lex_buffer(compiler, &compilation->scratch)){
+        compiler_free_error(compiler);
+        compilation->tokens = NULL;
+    }
+
+    return compiler_read_file(compiler, root);
+}
+
+errorcode_t compilation_lex_tokens(compilation_t *out_compilation, query_t *query){
+    out_compilation->parse_kind = COMPILATION_PARSE_NONE;
+    out_compilation->succeeded = false;
+    out_compilation->func_id = INVALID_FUNC_ID;
+    out_compilation->focus = NULL;
+    out_compilation->query = query;
+    out_compilation->scratch.compilation_stage = COMPILATION_STAGE_NONE;
+
+    // The cached compiler is left alone, so that the next compilation can still reuse it
+    out_compilation->compiler = compilation_new_compiler();
+    return compilation_lex_standalone(out_compilation, query, false);
+}
+
+errorcode_t compilation_lex(compilation_t *out_compilation, query_t *query){
+    out_compilation->parse_kind = COMPILATION_PARSE_FULL;
+    out_compilation->succeeded = false;
+    out_compilation->func_id = INVALID_FUNC_ID;
+    out_compilation->focus = NULL;
+    out_compilation->query = query;
+    out_compilation->scratch.compilation_stage = COMPILATION_STAGE_NONE;
+
+    // Watch the workspace and the infrastructure for changes
+    file_watcher_watch(query->filename);
+    file_watcher_watch(query->infrastructure);
+    compilation_apply_file_changes();
+
+    // Files that belong to a project are compiled from its entry point
+    maybe_null_weak_cstr_t entry = NULL;
+
+    if((query->features & QUERY_FEATURE_PROJECT) && file_exists(query->filename)){
+        out_compilation->focus = filename_absolute(query->filename);
+        if(out_compilation->focus) entry = project_find_entry(out_compilation->focus);
+
+        if(entry == NULL){
+            free(out_compilation->focus);
+            out_compilation->focus = NULL;
+        }
+    }
+
+    weak_cstr_t root_filename = entry ? entry : query->filename;
+
+    if(cached_compiler){
+        compiler_t *compiler = cached_compiler;
+        cached_compiler = NULL;
+
+        out_compilation->compiler = compiler;
+        out_compilation->root = compiler->objects[0];
+        out_compilation->object = entry ? compilation_find_object(compiler, out_compilation->focus) : out_compilation->root;
+        out_compilation->tokens = out_compilation->object;
+
+        if(cached_reparses < COMPILATION_MAX_REPARSES
+        && out_compilation->object
+        && compilation_matches_query(compiler, query, root_filename)
+        && compilation_prepare_reparse(out_compilation, query) == SUCCESS){
+            compilation_publish_buffer(out_compilation->object);
+            return SUCCESS;
+        }
+
+        out_compilation->parse_kind = COMPILATION_PARSE_FULL;
+        compilation_discard(compiler);
+    }
+
+    out_compilation->compiler = compilation_new_compiler();
+
+    if(entry){
+        return compilation_lex_project(out_compilation, query, entry);
+    } else {
+        return compilation_lex_standalone(out_compilation, query, true);
+    }
+}
+
+static errorcode_t compilation_reparse_func_body(compilation_t *compilation){
+    compiler_t *compiler = compilation->compiler;
+    object_t *object = compilation->object;
+    ast_t *ast = &compilation->root->ast;
+
+    ast_shift_t shift = {
+        .object_index = object->index,
+        .old_end = compilation->old_body_end_index,
+        .new_end = compilation->new_body_end_index,
+    };
+
+    // Forget warnings from the previous version of the function body
+    length_t warnings_kept = 0;
+
+    for(length_t i = 0; i != compiler->warnings_length; i++){
+        source_t *source = &compiler->warnings[i].source;
+
+        if(source->object_index == object->index
+        && source->index > compilation->body_begin_index
+        && source->index <= compilation->old_body_end_index){
+            continue;
+        }
+
+        ast_shift_source(&shift, source);
+        compiler->warnings[warnings_kept++] = compiler->warnings[i];
+    }
+
+    compiler->warnings_length = warnings_kept;
+
+    // Move everything after the function body, including the sources nested within declarations
+    ast_shift_all(&shift, ast);
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+        if(func->source.object_index != object->index) continue;
+
+        if(func->body_token_index > compilation->old_body_end_token){
+            func->body_token_index = func->body_token_index - compilation->old_body_end_token + compilation->new_body_end_token;
+        }
+    }
+
+    return parse_func_reparse_body(compiler, ast, compilation->func_id);
+}
+
+static errorcode_t compilation_parse_standalone(compilation_t *compilation){
+    // Compiles the file of the query by itself, since its project doesn't import it
+    compiler_t *compiler = compilation->compiler;
+    query_t *query = compilation->query;
+
+    free(compilation->focus);
+    compilation->focus = NULL;
+    compiler_reset(compiler);
+
+    if(compilation_lex_standalone(compilation, query, true)) return FAILURE;
+    return parse(compiler, compilation->root);
+}
+
+static errorcode_t compilation_parse_project(compilation_t *compilation, errorcode_t errorcode){
+    compiler_t *compiler = compilation->compiler;
+
+    if(compilation->object == NULL){
+        compilation->object = compilation_find_object(compiler, compilation->focus);
+
+        if(compilation->object == NULL){
+            // Remember to not bother with the project next time, unless it couldn't be fully parsed
+            if(errorcode == SUCCESS) project_exclude(compilation->focus);
+            return compilation_parse_standalone(compilation);
+        }
+    }
+
+    if(errorcode){
+        // Errors within other files of the project shouldn't take away the AST of the file of the query,
+        // so it's compiled by itself instead
+        adept_error_t *error = compiler->error;
+        bool is_within_focus = error && error->source.object_index == compilation->object->index;
+
+        return is_within_focus ? errorcode : compilation_parse_standalone(compilation);
+    }
+
+    // Bodies of the file of the query are needed, even though it is imported
+    // NOTE: Bodies that were already parsed are left alone
+    ast_t *ast = &compilation->root->ast;
+    length_t object_index = compilation->object->index;
+
+    for(func_id_t i = 0; i != ast->funcs_length; i++){
+        if(ast->funcs[i].source.object_index == object_index && parse_func_lazy_body(compiler, ast, i)) return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t compilation_parse(compilation_t *compilation){
+    errorcode_t errorcode = SUCCESS;
+
+    switch(compilation->parse_kind){
+    case COMPILATION_PARSE_FULL:
+        errorcode = parse(compilation->compiler, compilation->root);
+        break;
+    case COMPILATION_PARSE_FUNC_BODY:
+        errorcode = compilation_reparse_func_body(compilation);
+        break;
+    case COMPILATION_PARSE_NONE:
+        break;
+    }
+
+    if(compilation->focus) errorcode = compilation_parse_project(compilation, errorcode);
+    if(errorcode) return FAILURE;
+
+    compilation->succeeded = true;
+    return SUCCESS;
+}
+
+void compilation_finish(compilation_t *compilation){
+    compiler_t *compiler = compilation->compiler;
+
+    free(compilation->focus);
+
+    if(compilation->scratch.compilation_stage == COMPILATION_STAGE_TOKENLIST){
+        tokenlist_free(&compilation->scratch.tokenlist);
+    }
+
+    if(!compilation->succeeded || compiler->error){
+        compilation_discard(compiler);
+        return;
+    }
+
+    switch(compilation->parse_kind){
+    case COMPILATION_PARSE_FULL:
+        cached_reparses = 0;
+        break;
+    case COMPILATION_PARSE_FUNC_BODY:
+        cached_reparses++;
+        break;
+    case COMPILATION_PARSE_NONE:
+        break;
+    }
+
+    // Keep the compiler around for the next query
+    cached_compiler = compiler;
+}
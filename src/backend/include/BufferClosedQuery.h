@@ -0,0 +1,10 @@
+
+#ifndef _ISAAC_BUFFER_CLOSED_QUERY_H
+#define _ISAAC_BUFFER_CLOSED_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_buffer_closed_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_BUFFER_CLOSED_QUERY_H
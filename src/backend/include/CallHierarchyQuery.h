@@ -0,0 +1,11 @@
+#ifndef _ISAAC_CALL_HIERARCHY_QUERY_H
+#define _ISAAC_CALL_HIERARCHY_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_call_hierarchy_query(query_t *query, json_builder_t *builder);
+void handle_incoming_calls_query(query_t *query, json_builder_t *builder);
+void handle_outgoing_calls_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_CALL_HIERARCHY_QUERY_H
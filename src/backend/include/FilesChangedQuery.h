@@ -0,0 +1,10 @@
+
+#ifndef _ISAAC_FILES_CHANGED_QUERY_H
+#define _ISAAC_FILES_CHANGED_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_files_changed_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_FILES_CHANGED_QUERY_H
@@ -0,0 +1,10 @@
+#ifndef _ISAAC_FOLDING_RANGES_QUERY_H
+#define _ISAAC_FOLDING_RANGES_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_folding_ranges_query(query_t *query, json_builder_t *builder);
+void handle_selection_ranges_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_FOLDING_RANGES_QUERY_H
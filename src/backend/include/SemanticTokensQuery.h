@@ -0,0 +1,28 @@
+#ifndef _ISAAC_SEMANTIC_TOKENS_QUERY_H
+#define _ISAAC_SEMANTIC_TOKENS_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+// ---------------- semantic_token_type_t ----------------
+// Kind of semantic token
+// NOTE: Must be in the same order as the legend that the frontend gives to the client
+typedef enum {
+    SEMANTIC_TOKEN_KEYWORD,
+    SEMANTIC_TOKEN_FUNCTION,
+    SEMANTIC_TOKEN_TYPE,
+    SEMANTIC_TOKEN_ENUM_MEMBER,
+    SEMANTIC_TOKEN_STRING,
+    SEMANTIC_TOKEN_NUMBER,
+    SEMANTIC_TOKEN_TYPE_PARAMETER,
+    SEMANTIC_TOKEN_NONE
+} semantic_token_type_t;
+
+void handle_semantic_tokens_query(query_t *query, json_builder_t *builder);
+
+// ---------------- semantic_tokens_forget ----------------
+// Forgets the previous semantic tokens of a file,
+// which are kept so that later queries can give only what changed
+void semantic_tokens_forget(weak_cstr_t filename);
+
+#endif // _ISAAC_SEMANTIC_TOKENS_QUERY_H
@@ -0,0 +1,9 @@
+#ifndef _ISAAC_SIGNATURE_HELP_QUERY_H
+#define _ISAAC_SIGNATURE_HELP_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_signature_help_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_SIGNATURE_HELP_QUERY_H
@@ -0,0 +1,10 @@
+#ifndef _ISAAC_SYMBOLS_QUERY_H
+#define _ISAAC_SYMBOLS_QUERY_H
+
+#include "query.h"
+#include "json_builder.h"
+
+void handle_symbols_query(query_t *query, json_builder_t *builder);
+void handle_workspace_symbols_query(query_t *query, json_builder_t *builder);
+
+#endif // _ISAAC_SYMBOLS_QUERY_H
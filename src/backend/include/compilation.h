@@ -0,0 +1,77 @@
+
+#ifndef _ISAAC_COMPILATION_H
+#define _ISAAC_COMPILATION_H
+
+#include "query.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+
+// ---------------- compilation_parse_kind_t ----------------
+// How much of a compilation has to be parsed
+typedef enum {
+    COMPILATION_PARSE_FULL,
+    COMPILATION_PARSE_FUNC_BODY,
+    COMPILATION_PARSE_NONE
+} compilation_parse_kind_t;
+
+// ---------------- compilation_t ----------------
+// The compilation of the code given by a query,
+// which may be an incremental update of the previous compilation
+// When the file of the query belongs to a project, the whole project
+// is compiled from its entry point instead of just the file itself
+typedef struct {
+    compiler_t *compiler;
+    object_t *root;   // Object that compilation started from, which owns the AST
+    object_t *object; // Object of the file of the query (can be NULL until parsed)
+    object_t *tokens; // Object with the unparsed tokens of the code of the query
+    compilation_parse_kind_t parse_kind;
+    bool succeeded;
+
+    // Only used when compiling a project
+    maybe_null_strong_cstr_t focus; // Absolute filename of the file of the query
+    object_t scratch;               // Holds the tokens of the code until the file is imported
+    query_t *query;
+
+    // Only used for COMPILATION_PARSE_FUNC_BODY
+    func_id_t func_id;
+    length_t body_begin_index;
+    length_t old_body_end_index;
+    length_t new_body_end_index;
+    length_t old_body_end_token;
+    length_t new_body_end_token;
+} compilation_t;
+
+// ---------------- compilation_lex ----------------
+// Creates the compilation for a query and lexes its code
+// When the only difference from the previous compilation of the same file
+// is within a single function body, the previous compilation is reused
+// Changes to files on disk are applied beforehand, so that nothing stale is reused
+// The code is also kept as the unsaved contents of the file for other files that import it
+// NOTE: Takes ownership of 'query->code', or borrows it until finished when compiling a project
+// NOTE: 'out_compilation' must be finished with 'compilation_finish'
+//       regardless of whether lexing was successful
+errorcode_t compilation_lex(compilation_t *out_compilation, query_t *query);
+
+// ---------------- compilation_lex_tokens ----------------
+// Creates a compilation that only lexes the code of a query by itself,
+// for queries that only need its tokens
+// The previous compilation is left alone, so that it can still be reused afterwards
+// NOTE: Takes ownership of 'query->code'
+// NOTE: 'out_compilation' must be finished with 'compilation_finish',
+//       and can't be parsed
+errorcode_t compilation_lex_tokens(compilation_t *out_compilation, query_t *query);
+
+// ---------------- compilation_parse ----------------
+// Parses a lexed compilation, only reparsing the body of
+// the edited function when the previous compilation is reused
+// When the entry point of a project turns out not to import the file of the query,
+// the file is compiled by itself instead, and 'compilation->compiler' is reset
+errorcode_t compilation_parse(compilation_t *compilation);
+
+// ---------------- compilation_finish ----------------
+// Finishes using a compilation, keeping it around
+// for reuse by the next query if it was successful
+void compilation_finish(compilation_t *compilation);
+
+#endif // _ISAAC_COMPILATION_H
@@ -25,6 +25,7 @@ void json_builder_free(json_builder_t *builder);
 void json_build_string(json_builder_t *builder, weak_cstr_t string);
 void json_build_integer(json_builder_t *builder, long long integer);
 void json_build_null(json_builder_t *builder);
+void json_build_boolean(json_builder_t *builder, bool boolean);
 void json_build_next(json_builder_t *builder);
 
 void json_build_array_start(json_builder_t *builder);
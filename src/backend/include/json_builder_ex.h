@@ -22,5 +22,10 @@ void json_build_func_parameters(
 );
 
 void json_build_composite_definition(json_builder_t *builder, ast_composite_t *composite);
+void json_build_func_alias_definition(json_builder_t *builder, ast_func_alias_t *falias);
+void json_build_enum_definition(json_builder_t *builder, ast_enum_t *enum_value);
+void json_build_alias_definition(json_builder_t *builder, ast_alias_t *alias);
+void json_build_named_expression_definition(json_builder_t *builder, ast_named_expression_t *named_expression);
+void json_build_global_definition(json_builder_t *builder, ast_global_t *global);
 
 #endif // _ISAAC_JSON_BUILDER_EX_H
@@ -0,0 +1,33 @@
+#ifndef _ISAAC_LINE_INDEX_H
+#define _ISAAC_LINE_INDEX_H
+
+#include "UTIL/ground.h"
+
+// ---------------- line_index_t ----------------
+// Offsets at which each line of a buffer begins,
+// for converting offsets into lines and characters
+typedef struct {
+    length_t *line_begins;
+    length_t length;
+    length_t capacity;
+    length_t buffer_length;
+} line_index_t;
+
+// ---------------- line_index_init ----------------
+// Creates the line index of a buffer
+void line_index_init(line_index_t *index, const char *buffer, length_t buffer_length);
+
+// ---------------- line_index_free ----------------
+// Frees a line index
+void line_index_free(line_index_t *index);
+
+// ---------------- line_index_position ----------------
+// Gets the zero-indexed line and character of an offset into the buffer
+void line_index_position(const line_index_t *index, length_t offset, length_t *out_line, length_t *out_character);
+
+// ---------------- line_index_offset ----------------
+// Gets the offset into the buffer of a zero-indexed line and character
+// The character is clamped to the end of the line, and the line to the end of the buffer
+length_t line_index_offset(const line_index_t *index, length_t line, length_t character);
+
+#endif // _ISAAC_LINE_INDEX_H
@@ -0,0 +1,79 @@
+#ifndef _ISAAC_NAME_SEARCH_H
+#define _ISAAC_NAME_SEARCH_H
+
+/*
+    =============================== name_search.h ===============================
+    Ranked search of interned names by what they contain
+
+    Every distinct name is interned once, and the trigrams of its lowercased
+    form are added to an inverted index. Names that contain a search text are
+    found by intersecting the lists of the trigrams of the text, which only
+    ever visits names that share all of them, rather than every known name.
+
+    Names are never removed, but each one counts its uses, and names that
+    aren't used anymore are left out of results. This keeps the index cheap
+    to maintain as the names that are in use change.
+
+    NOTE: Search is case-insensitive, and exact and leading matches rank first
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/name_index.h"
+
+// ---------------- name_search_postings_t ----------------
+// The names that contain a trigram, in ascending order
+typedef struct {
+    length_t *names;
+    length_t length;
+    length_t capacity;
+} name_search_postings_t;
+
+// ---------------- name_search_t ----------------
+// Interned names and the trigrams that they contain
+typedef struct {
+    strong_cstr_t *names;
+    strong_cstr_t *lowered;
+    length_t *uses;
+    length_t length;
+    length_t capacity;
+    name_index_t index;
+
+    // Lazily allocated, with an entry for every possible trigram
+    name_search_postings_t *postings;
+} name_search_t;
+
+// ---------------- name_search_match_t ----------------
+// A name that was found, and how well it matches
+typedef struct {
+    length_t name;
+    int score;
+} name_search_match_t;
+
+// ---------------- name_search_match_list_t ----------------
+// Names that were found, best first
+typedef listof(name_search_match_t, matches) name_search_match_list_t;
+
+// ---------------- name_search_init ----------------
+// Initializes an empty name search
+void name_search_init(name_search_t *search);
+
+// ---------------- name_search_free ----------------
+// Frees a name search
+void name_search_free(name_search_t *search);
+
+// ---------------- name_search_use ----------------
+// Counts a use of a name, and interns it if it isn't yet
+// Returns the name's identifier, which stays the same for as long as the search exists
+length_t name_search_use(name_search_t *search, weak_cstr_t name);
+
+// ---------------- name_search_release ----------------
+// Forgets a use of a name
+void name_search_release(name_search_t *search, length_t name);
+
+// ---------------- name_search_find ----------------
+// Finds the best used names that contain some text, up to a limit
+name_search_match_list_t name_search_find(name_search_t *search, weak_cstr_t text, length_t limit);
+
+#endif // _ISAAC_NAME_SEARCH_H
@@ -0,0 +1,30 @@
+
+#ifndef _ISAAC_PROJECT_H
+#define _ISAAC_PROJECT_H
+
+#include "UTIL/ground.h"
+
+// ---------------- PROJECT_ENTRY_FILENAME ----------------
+// Name of the file that is the entry point of a project
+#define PROJECT_ENTRY_FILENAME "main.adept"
+
+// ---------------- project_find_entry ----------------
+// Finds the entry point of the project that a file belongs to,
+// which is the closest 'main.adept' in the directory of the file or its parents
+// The search doesn't go above the root of a git repository
+// Returns the absolute filename of the entry point,
+// or NULL when there isn't one, it is the file itself, or the file was excluded
+// NOTE: 'absolute' is the absolute filename of the file
+// NOTE: Results are remembered, so this doesn't touch the filesystem after the first time
+maybe_null_weak_cstr_t project_find_entry(weak_cstr_t absolute);
+
+// ---------------- project_exclude ----------------
+// Remembers that a file turned out not to be imported by the entry point of its project
+void project_exclude(weak_cstr_t absolute);
+
+// ---------------- project_file_changed ----------------
+// Forgets what was remembered that could be affected by a change to a file
+// NOTE: 'absolute' can be NULL to report that anything could have changed
+void project_file_changed(maybe_null_weak_cstr_t absolute, bool existence);
+
+#endif // _ISAAC_PROJECT_H
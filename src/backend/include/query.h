@@ -4,6 +4,7 @@
 #define _ISAAC_QUERY_H
 
 #include "UTIL/ground.h"
+#include "UTIL/string_list.h"
 #include "UTIL/trait.h"
 #include "json_builder.h"
 
@@ -12,7 +13,23 @@
 typedef enum {
     QUERY_KIND_UNRECOGNIZED,
     QUERY_KIND_VALIDATE,
-    QUERY_KIND_AST
+    QUERY_KIND_AST,
+    QUERY_KIND_FILES_CHANGED,
+    QUERY_KIND_BUFFER_CLOSED,
+    QUERY_KIND_DEPENDENTS,
+    QUERY_KIND_SEMANTIC_TOKENS,
+    QUERY_KIND_INLAY_HINTS,
+    QUERY_KIND_DOCUMENT_SYMBOLS,
+    QUERY_KIND_REFERENCES,
+    QUERY_KIND_CALL_HIERARCHY,
+    QUERY_KIND_INCOMING_CALLS,
+    QUERY_KIND_OUTGOING_CALLS,
+    QUERY_KIND_SIGNATURE_HELP,
+    QUERY_KIND_SYMBOLS,
+    QUERY_KIND_INDEX_WORKSPACE,
+    QUERY_KIND_WORKSPACE_SYMBOLS,
+    QUERY_KIND_FOLDING_RANGES,
+    QUERY_KIND_SELECTION_RANGES
 } query_kind_t;
 
 
@@ -21,6 +38,8 @@ typedef trait_t query_features_t;
 #define QUERY_FEATURE_NONE TRAIT_NONE
 #define QUERY_FEATURE_INCLUDE_ARG_INFO TRAIT_1
 #define QUERY_FEATURE_INCLUDE_CALLS TRAIT_2
+#define QUERY_FEATURE_PROJECT TRAIT_3
+#define QUERY_FEATURE_MATCH_PREFIX TRAIT_4
 
 // ---------------- query_t ----------------
 // A Query
@@ -31,6 +50,16 @@ typedef struct {
     maybe_null_strong_cstr_t code;
     bool warnings;
     query_features_t features;
+    strong_cstr_list_t files;
+    maybe_null_strong_cstr_t previous_result_id;
+    maybe_null_strong_cstr_t name;
+
+    // Range of the code that is of interest, as zero-indexed lines and characters
+    bool has_range;
+    length_t range_start_line;
+    length_t range_start_character;
+    length_t range_end_line;
+    length_t range_end_character;
 } query_t;
 
 // ---------------- query_t ----------------
@@ -0,0 +1,18 @@
+#ifndef _ISAAC_SERVER_INPUT_H
+#define _ISAAC_SERVER_INPUT_H
+
+#include "UTIL/ground.h"
+
+// ---------------- server_input_unbuffered ----------------
+// Makes reading from standard input not buffer ahead,
+// so that 'server_input_pending' can see every message that hasn't been read
+// NOTE: Must be called before anything is read from standard input
+extern void server_input_unbuffered(void);
+
+// ---------------- server_input_pending ----------------
+// Returns whether there is input waiting to be read from standard input,
+// without waiting for any to arrive
+// NOTE: Always returns true when this can't be determined
+extern bool server_input_pending(void);
+
+#endif // _ISAAC_SERVER_INPUT_H
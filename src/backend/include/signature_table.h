@@ -0,0 +1,58 @@
+#ifndef _ISAAC_SIGNATURE_TABLE_H
+#define _ISAAC_SIGNATURE_TABLE_H
+
+#include "AST/ast.h"
+#include "DRVR/compiler.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/list.h"
+
+// ---------------- signature_param_t ----------------
+// A formatted parameter of a signature
+typedef struct {
+    maybe_null_strong_cstr_t name;
+    strong_cstr_t type;
+    maybe_null_strong_cstr_t default_value;
+
+    // Where the parameter is within the label of its signature
+    length_t label_begin;
+    length_t label_end;
+} signature_param_t;
+
+// ---------------- signature_t ----------------
+// The formatted signature of a version of a function
+// Signatures are shared by every function of the same file with the same version,
+// and are freed once an update of the table finds that they're no longer used
+typedef struct {
+    hash_t version;
+    strong_cstr_t name;
+    strong_cstr_t label;      // Such as "add(a int, b int = 1) int"
+    strong_cstr_t definition; // As given by 'json_build_func_definition', so already a JSON string
+    signature_param_t *params;
+    length_t arity;
+    bool is_variadic;         // Whether any number of arguments can follow the parameters
+    length_t references;      // Number of overload sets that borrow the signature
+    length_t generation;      // Last update of the table that the signature was used in
+} signature_t;
+
+// ---------------- signature_list_t ----------------
+// A list of borrowed signatures
+typedef listof(signature_t*, signatures) signature_list_t;
+
+// ---------------- signature_get ----------------
+// Gets the signature of a function
+// The function is only formatted when no function with the same version has been formatted before
+// NOTE: The signature is only borrowed until the next 'signature_table_update'
+signature_t *signature_get(compiler_t *compiler, ast_func_t *func);
+
+// ---------------- signature_table_update ----------------
+// Replaces the overload sets of a document with the functions of its AST,
+// and forgets the signatures of the compiled files that are no longer used
+void signature_table_update(weak_cstr_t absolute, compiler_t *compiler, ast_t *ast);
+
+// ---------------- signature_table_find ----------------
+// Finds the overloads of a name within the table of a document, in the order they were declared
+// NOTE: Only the array of the list has to be freed
+signature_list_t signature_table_find(weak_cstr_t absolute, weak_cstr_t name);
+
+#endif // _ISAAC_SIGNATURE_TABLE_H
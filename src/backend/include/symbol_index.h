@@ -0,0 +1,111 @@
+#ifndef _ISAAC_SYMBOL_INDEX_H
+#define _ISAAC_SYMBOL_INDEX_H
+
+/*
+    ============================== symbol_index.h ==============================
+    Process-wide index of the declarations of every compiled file
+
+    The index is kept in a cache file for each infrastructure and compiler
+    version, so declarations of files that haven't changed since an earlier
+    run (such as those of the standard library) are known without compiling
+    them again. The cache file is mapped into memory as is, so loading it is
+    nearly free, and concurrent servers share its pages.
+
+    Files are only indexed again when the hash of their content changes.
+
+    NOTE: Not thread-safe
+    ----------------------------------------------------------------------------
+*/
+
+#include "AST/ast.h"
+#include "DRVR/compiler.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/list.h"
+
+// ---------------- symbol_kind_t ----------------
+// Kind of declaration
+// NOTE: Values are stored in cache files, so existing values must never change
+typedef enum {
+    SYMBOL_KIND_FUNCTION,
+    SYMBOL_KIND_FUNCTION_ALIAS,
+    SYMBOL_KIND_COMPOSITE,
+    SYMBOL_KIND_ENUM,
+    SYMBOL_KIND_ALIAS,
+    SYMBOL_KIND_NAMED_EXPRESSION,
+    SYMBOL_KIND_GLOBAL,
+    SYMBOL_KIND_COUNT,
+} symbol_kind_t;
+
+// ---------------- symbol_t ----------------
+// A declaration within the index
+// NOTE: Strings are borrowed from the index, and are only valid until it next changes
+typedef struct {
+    weak_cstr_t name;
+    weak_cstr_t definition; // Already a JSON string
+    weak_cstr_t filename;
+    symbol_kind_t kind;
+    length_t line;          // Zero-indexed
+    length_t character;     // Zero-indexed
+} symbol_t;
+
+// ---------------- symbol_declaration_t ----------------
+// A declaration that was found without compiling its file
+typedef struct {
+    strong_cstr_t name;
+    strong_cstr_t definition; // Already a JSON string
+    symbol_kind_t kind;
+    length_t line;
+    length_t character;
+} symbol_declaration_t;
+
+// ---------------- symbol_declaration_list_t ----------------
+// A list of declarations of a file
+typedef listof(symbol_declaration_t, declarations) symbol_declaration_list_t;
+
+// ---------------- symbol_list_t ----------------
+// A list of symbols
+// NOTE: Only the array of the list has to be freed
+typedef listof(symbol_t, symbols) symbol_list_t;
+
+// ---------------- symbol_index_open ----------------
+// Loads the cached index of an infrastructure, unless it's already loaded
+void symbol_index_open(weak_cstr_t infrastructure);
+
+// ---------------- symbol_index_update ----------------
+// Indexes the declarations of every file of a successfully parsed AST whose content has changed,
+// and writes the index back to its cache file every so often
+void symbol_index_update(compiler_t *compiler, ast_t *ast);
+
+// ---------------- symbol_index_replace ----------------
+// Replaces the declarations of a file with ones that were found without compiling it,
+// unless the file was already compiled with the same content, or was compiled while it's open
+// Files indexed this way are indexed again the next time that they're compiled
+void symbol_index_replace(weak_cstr_t absolute, text_version_t version, symbol_declaration_list_t *declarations);
+
+// ---------------- symbol_declaration_list_free ----------------
+// Frees a list of declarations
+void symbol_declaration_list_free(symbol_declaration_list_t *list);
+
+// ---------------- symbol_index_forget ----------------
+// Forgets the declarations of a file given its absolute filename
+void symbol_index_forget(weak_cstr_t absolute);
+
+// ---------------- symbol_index_save ----------------
+// Writes the index to its cache file if it has changed since it was last written
+successful_t symbol_index_save(void);
+
+// ---------------- symbol_index_find ----------------
+// Finds the declarations that have a name, or that begin with it when 'is_prefix'
+symbol_list_t symbol_index_find(weak_cstr_t name, bool is_prefix);
+
+// ---------------- symbol_index_search ----------------
+// Finds the declarations whose names best match some text, best first, up to a limit
+// Names match when they contain the text, ignoring case
+symbol_list_t symbol_index_search(weak_cstr_t text, length_t limit);
+
+// ---------------- symbol_kind_name ----------------
+// Gets the name of a kind of declaration, such as "function"
+weak_cstr_t symbol_kind_name(symbol_kind_t kind);
+
+#endif // _ISAAC_SYMBOL_INDEX_H
@@ -0,0 +1,43 @@
+#ifndef _ISAAC_TOKEN_RANGE_H
+#define _ISAAC_TOKEN_RANGE_H
+
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+
+// ---------------- token_range_t ----------------
+// Range of tokens within a token list, 'end' is exclusive
+typedef struct {
+    length_t begin;
+    length_t end;
+} token_range_t;
+
+// ---------------- token_range_offset ----------------
+// Gets the offset into a buffer of a zero-indexed line and character.
+// The character is clamped to the end of the line, and the line to the end of the buffer.
+// If 'out_line_begin' isn't NULL, it will receive the offset at which the line begins
+length_t token_range_offset(const char *buffer, length_t buffer_length, length_t line, length_t character, length_t *out_line_begin);
+
+// ---------------- token_range_offset_from ----------------
+// Same as 'token_range_offset', except lines are counted from an earlier line
+// that is already known to begin at 'from_line_begin', instead of from the beginning of the buffer
+length_t token_range_offset_from(const char *buffer, length_t buffer_length, length_t from_line, length_t from_line_begin,
+    length_t line, length_t character, length_t *out_line_begin);
+
+// ---------------- token_range_first_at ----------------
+// Finds the index of the first token that begins at or after an offset
+// Returns the length of the token list if there is no such token
+length_t token_range_first_at(tokenlist_t *tokenlist, length_t offset);
+
+// ---------------- token_range_between ----------------
+// Finds the tokens that begin within a range of lines and characters
+// If 'out_start_line_begin' isn't NULL, it will receive the offset at which the start line begins
+token_range_t token_range_between(tokenlist_t *tokenlist, const char *buffer, length_t buffer_length,
+    length_t start_line, length_t start_character, length_t end_line, length_t end_character, length_t *out_start_line_begin);
+
+// ---------------- token_range_word ----------------
+// Copies the text of a token from the buffer into a null-terminated string
+// NOTE: The data of word tokens is taken by parsing, so their text is read from the buffer instead
+// Returns false if the text doesn't fit
+successful_t token_range_word(tokenlist_t *tokenlist, const char *buffer, length_t index, char *out_word, length_t capacity);
+
+#endif // _ISAAC_TOKEN_RANGE_H
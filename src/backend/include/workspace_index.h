@@ -0,0 +1,48 @@
+#ifndef _ISAAC_WORKSPACE_INDEX_H
+#define _ISAAC_WORKSPACE_INDEX_H
+
+/*
+    ============================= workspace_index.h =============================
+    Background indexer for the declarations of every file within the workspace
+
+    Worker threads find the Adept files within the folders of the workspace,
+    and lex each one to find its declarations without parsing or compiling it.
+    Workers only run while no query is being handled, and rest between files,
+    so that they stay out of the way of interactive requests.
+
+    What workers find is moved into the symbol index by the thread that
+    handles queries, whenever it asks for it.
+
+    NOTE: Only the thread that handles queries may call these functions
+    NOTE: Without threads, files are instead indexed a few at a time whenever
+          declarations are collected
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+#include "UTIL/string_list.h"
+
+// ---------------- workspace_index_start ----------------
+// Starts indexing the Adept files within some folders
+// Folders that are already being indexed are ignored
+void workspace_index_start(strong_cstr_list_t *folders);
+
+// ---------------- workspace_index_refresh ----------------
+// Indexes a file again if it's within the workspace, such as after it changed on disk
+void workspace_index_refresh(weak_cstr_t absolute);
+
+// ---------------- workspace_index_collect ----------------
+// Moves the declarations found so far into the symbol index
+// NOTE: The symbol index must already be open
+// Returns whether files are still being indexed
+bool workspace_index_collect(void);
+
+// ---------------- workspace_index_pause ----------------
+// Keeps workers from starting on more files while a query is handled
+void workspace_index_pause(void);
+
+// ---------------- workspace_index_resume ----------------
+// Lets workers continue after a query has been handled
+void workspace_index_resume(void);
+
+#endif // _ISAAC_WORKSPACE_INDEX_H
@@ -31,6 +31,10 @@ void json_build_null(json_builder_t *builder){
     json_builder_append(builder, "null");
 }
 
+void json_build_boolean(json_builder_t *builder, bool boolean){
+    json_builder_append(builder, boolean ? "true" : "false");
+}
+
 void json_build_next(json_builder_t *builder){
     json_builder_append(builder, ",");
 }
@@ -69,7 +73,9 @@ void json_build_object_end(json_builder_t *builder){
 
 void json_builder_append(json_builder_t *builder, weak_cstr_t string){
     length_t string_length = strlen(string);
+
     expand((void**) &builder->buffer, sizeof(char), builder->length, &builder->capacity, string_length + 1, 2048);
+
     memcpy(&builder->buffer[builder->length], string, string_length + 1);
     builder->length += string_length;
 }
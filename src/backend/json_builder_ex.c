@@ -1,4 +1,5 @@
 
+#include "AST/ast_expr.h"
 #include "AST/ast_type.h"
 #include "AST/TYPE/ast_type_identical.h"
 #include "json_builder_ex.h"
@@ -146,3 +147,81 @@ void json_build_composite_definition(json_builder_t *builder, ast_composite_t *c
 
     json_builder_append(builder, ")\"");
 }
+
+void json_build_func_alias_definition(json_builder_t *builder, ast_func_alias_t *falias){
+    json_builder_append(builder, "\"");
+    json_builder_append(builder, "func alias ");
+    json_builder_append_escaped(builder, falias->from);
+
+    if(!falias->match_first_of_name){
+        json_build_func_parameters(builder, NULL, falias->arg_types, NULL, NULL, falias->arity, falias->required_traits, NULL);
+    }
+    
+    json_builder_append(builder, " => ");
+    json_builder_append_escaped(builder, falias->to);
+
+    json_builder_append(builder, "\"");
+}
+
+void json_build_enum_definition(json_builder_t *builder, ast_enum_t *enum_value){
+    json_builder_append(builder, "\"enum ");
+    json_builder_append_escaped(builder, enum_value->name);
+    json_builder_append(builder, " (");
+    for(length_t i = 0; i != enum_value->length; i++){
+        json_builder_append_escaped(builder, enum_value->kinds[i]);
+        json_builder_append(builder, ", ");
+    }
+    if(enum_value->length != 0) json_builder_remove(builder, 2); // Remove trailing ', '
+    json_builder_append(builder, ")\"");
+}
+
+void json_build_alias_definition(json_builder_t *builder, ast_alias_t *alias){
+    json_builder_append(builder, "\"alias ");
+
+    if(alias->generics_length > 0){
+        json_builder_append(builder, "<");
+
+        for(length_t i = 0; i < alias->generics_length; i++){
+            if(i != 0){
+                json_builder_append(builder, ", ");
+            }
+
+            json_builder_append(builder, "$");
+            json_builder_append_escaped(builder, alias->generics[i]);
+        }
+
+        json_builder_append(builder, "> ");
+    }
+
+    json_builder_append_escaped(builder, alias->name);
+    json_builder_append(builder, " = ");
+
+    strong_cstr_t typename = ast_type_str(&alias->type);
+    json_builder_append_escaped(builder, typename);
+    free(typename);
+
+    json_builder_append(builder, "\"");
+}
+
+void json_build_named_expression_definition(json_builder_t *builder, ast_named_expression_t *named_expression){
+    json_builder_append(builder, "\"define ");
+    json_builder_append_escaped(builder, named_expression->name);
+    json_builder_append(builder, " = ");
+
+    strong_cstr_t value = ast_expr_str(named_expression->expression);
+    json_builder_append_escaped(builder, value);
+    free(value);
+    json_builder_append(builder, "\"");
+}
+
+void json_build_global_definition(json_builder_t *builder, ast_global_t *global){
+    json_builder_append(builder, "\"");
+    json_builder_append_escaped(builder, global->name);
+    json_builder_append(builder, " ");
+
+    strong_cstr_t typename = ast_type_str(&global->type);
+    json_builder_append_escaped(builder, typename);
+    free(typename);
+
+    json_builder_append(builder, "\"");
+}
@@ -0,0 +1,59 @@
+
+#include <string.h>
+
+#include "line_index.h"
+
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+static void line_index_add(line_index_t *index, length_t line_begin){
+    expand((void**) &index->line_begins, sizeof(length_t), index->length, &index->capacity, 1, 64);
+
+    index->line_begins[index->length++] = line_begin;
+}
+
+void line_index_init(line_index_t *index, const char *buffer, length_t buffer_length){
+    index->line_begins = NULL;
+    index->length = 0;
+    index->capacity = 0;
+    index->buffer_length = buffer_length;
+
+    line_index_add(index, 0);
+
+    const char *newline = buffer;
+    while((newline = memchr(newline, '\n', buffer_length - (newline - buffer)))){
+        newline++;
+        line_index_add(index, newline - buffer);
+    }
+}
+
+void line_index_free(line_index_t *index){
+    free(index->line_begins);
+}
+
+void line_index_position(const line_index_t *index, length_t offset, length_t *out_line, length_t *out_character){
+    // Find the last line that begins at or before the offset
+    length_t low = 0;
+    length_t high = index->length;
+
+    while(high - low > 1){
+        length_t middle = low + (high - low) / 2;
+
+        if(index->line_begins[middle] <= offset){
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    *out_line = low;
+    *out_character = offset - index->line_begins[low];
+}
+
+length_t line_index_offset(const line_index_t *index, length_t line, length_t character){
+    if(line >= index->length) return index->buffer_length;
+
+    length_t line_begin = index->line_begins[line];
+    length_t line_end = line + 1 < index->length ? index->line_begins[line + 1] - 1 : index->buffer_length;
+    return character < line_end - line_begin ? line_begin + character : line_end;
+}
@@ -0,0 +1,267 @@
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "name_search.h"
+
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Characters of trigrams are folded into letters, digits, '_', '\', and everything else
+#define NAME_SEARCH_CLASSES 39
+#define NAME_SEARCH_TRIGRAMS (NAME_SEARCH_CLASSES * NAME_SEARCH_CLASSES * NAME_SEARCH_CLASSES)
+
+// Kinds of matches, from best to worst
+// NOTE: Matches that only differ in case are ranked below those that don't
+#define NAME_SEARCH_SCORE_EXACT                 4000
+#define NAME_SEARCH_SCORE_EXACT_CASE_MISMATCH   3500
+#define NAME_SEARCH_SCORE_PREFIX                3000
+#define NAME_SEARCH_SCORE_PREFIX_CASE_MISMATCH  2500
+#define NAME_SEARCH_SCORE_WORD                  2000
+#define NAME_SEARCH_SCORE_CONTAINS              1000
+
+void name_search_init(name_search_t *search){
+    *search = (name_search_t){0};
+    name_index_init(&search->index);
+}
+
+void name_search_free(name_search_t *search){
+    for(length_t i = 0; i != search->length; i++){
+        free(search->names[i]);
+        free(search->lowered[i]);
+    }
+
+    if(search->postings){
+        for(length_t i = 0; i != NAME_SEARCH_TRIGRAMS; i++){
+            free(search->postings[i].names);
+        }
+    }
+
+    free(search->names);
+    free(search->lowered);
+    free(search->uses);
+    free(search->postings);
+    name_index_free(&search->index);
+}
+
+static length_t name_search_class(char c){
+    if(c >= 'a' && c <= 'z') return c - 'a';
+    if(c >= '0' && c <= '9') return 26 + (c - '0');
+    if(c == '_') return 36;
+    if(c == '\\') return 37;
+    return 38;
+}
+
+static length_t name_search_trigram(const char *lowered){
+    return (name_search_class(lowered[0]) * NAME_SEARCH_CLASSES + name_search_class(lowered[1])) * NAME_SEARCH_CLASSES + name_search_class(lowered[2]);
+}
+
+static strong_cstr_t name_search_lower(weak_cstr_t text){
+    strong_cstr_t lowered = strclone(text);
+
+    for(char *c = lowered; *c; c++){
+        *c = tolower((unsigned char) *c);
+    }
+
+    return lowered;
+}
+
+static void name_search_intern(name_search_t *search, weak_cstr_t name){
+    length_t id = search->length;
+
+    if(search->length == search->capacity){
+        search->capacity = search->capacity ? search->capacity * 2 : 1024;
+        search->names = realloc(search->names, sizeof(strong_cstr_t) * search->capacity);
+        search->lowered = realloc(search->lowered, sizeof(strong_cstr_t) * search->capacity);
+        search->uses = realloc(search->uses, sizeof(length_t) * search->capacity);
+    }
+
+    search->names[id] = strclone(name);
+    search->lowered[id] = name_search_lower(name);
+    search->uses[id] = 0;
+    search->length++;
+
+    // NOTE: Names are never moved, so they can be borrowed by the index
+    name_index_add(&search->index, search->names[id]);
+
+    if(search->postings == NULL){
+        search->postings = calloc(NAME_SEARCH_TRIGRAMS, sizeof(name_search_postings_t));
+    }
+
+    weak_cstr_t lowered = search->lowered[id];
+    length_t length = strlen(lowered);
+
+    for(length_t i = 0; i + 3 <= length; i++){
+        name_search_postings_t *postings = &search->postings[name_search_trigram(&lowered[i])];
+
+        // Names are added in ascending order, so a trigram that repeats within a name is only the last entry
+        if(postings->length != 0 && postings->names[postings->length - 1] == id) continue;
+
+        expand((void**) &postings->names, sizeof(length_t), postings->length, &postings->capacity, 1, 4);
+        postings->names[postings->length++] = id;
+    }
+}
+
+length_t name_search_use(name_search_t *search, weak_cstr_t name){
+    length_t id = name_index_find(&search->index, name);
+
+    if(id == NAME_INDEX_NONE){
+        id = search->length;
+        name_search_intern(search, name);
+    }
+
+    search->uses[id]++;
+    return id;
+}
+
+void name_search_release(name_search_t *search, length_t name){
+    if(name < search->length && search->uses[name] != 0) search->uses[name]--;
+}
+
+static bool name_search_is_word_start(weak_cstr_t name, length_t position){
+    char previous = name[position - 1];
+    return previous == '_' || previous == '\\' || (islower((unsigned char) previous) && isupper((unsigned char) name[position]));
+}
+
+static bool name_search_score(name_search_t *search, length_t id, weak_cstr_t text, weak_cstr_t lowered_text, length_t text_length, int *out_score){
+    weak_cstr_t name = search->names[id];
+    weak_cstr_t lowered = search->lowered[id];
+    const char *found = strstr(lowered, lowered_text);
+    if(found == NULL) return false;
+
+    length_t length = strlen(name);
+    length_t position = found - lowered;
+    int score;
+
+    if(length == text_length){
+        score = streq(name, text) ? NAME_SEARCH_SCORE_EXACT : NAME_SEARCH_SCORE_EXACT_CASE_MISMATCH;
+    } else if(position == 0){
+        score = strncmp(name, text, text_length) == 0 ? NAME_SEARCH_SCORE_PREFIX : NAME_SEARCH_SCORE_PREFIX_CASE_MISMATCH;
+    } else {
+        score = NAME_SEARCH_SCORE_CONTAINS;
+
+        // Matches at the beginning of a word within the name, such as "Symbol" within "getSymbol", are better
+        while(found){
+            if(name_search_is_word_start(name, found - lowered)){
+                position = found - lowered;
+                score = NAME_SEARCH_SCORE_WORD;
+                break;
+            }
+
+            found = strstr(found + 1, lowered_text);
+        }
+    }
+
+    // Shorter names, and matches closer to the beginning, are closer to what was asked for
+    *out_score = score - (int) (length < 200 ? length : 200) * 2 - (int) (position < 200 ? position : 200);
+    return true;
+}
+
+static bool name_search_is_better(name_search_t *search, name_search_match_t *a, name_search_match_t *b){
+    if(a->score != b->score) return a->score > b->score;
+    return strcmp(search->names[a->name], search->names[b->name]) < 0;
+}
+
+static void name_search_consider(name_search_t *search, name_search_match_list_t *matches, length_t limit, name_search_match_t match){
+    // Only the best matches are kept, in order, so finding them never sorts every match
+    if(matches->length == limit && !name_search_is_better(search, &match, &matches->matches[limit - 1])) return;
+
+    length_t position = matches->length == limit ? limit - 1 : matches->length++;
+
+    while(position != 0 && name_search_is_better(search, &match, &matches->matches[position - 1])){
+        matches->matches[position] = matches->matches[position - 1];
+        position--;
+    }
+
+    matches->matches[position] = match;
+}
+
+static bool name_search_contains(name_search_postings_t *postings, length_t *cursor, length_t name){
+    // Finds a name within a list of names in ascending order, starting from where the last one was found
+    length_t low = *cursor;
+    length_t high = postings->length;
+
+    while(low < high){
+        length_t middle = low + (high - low) / 2;
+
+        if(postings->names[middle] < name){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    *cursor = low;
+    return low < postings->length && postings->names[low] == name;
+}
+
+name_search_match_list_t name_search_find(name_search_t *search, weak_cstr_t text, length_t limit){
+    name_search_match_list_t matches = {0};
+    if(limit == 0 || search->length == 0) return matches;
+
+    strong_cstr_t lowered_text = name_search_lower(text);
+    length_t text_length = strlen(lowered_text);
+
+    matches.matches = malloc(sizeof(name_search_match_t) * limit);
+    matches.capacity = limit;
+
+    if(text_length < 3){
+        // Text without any trigrams could be within any name
+        for(length_t id = 0; id != search->length; id++){
+            name_search_match_t match = {.name = id};
+
+            if(search->uses[id] != 0 && name_search_score(search, id, text, lowered_text, text_length, &match.score)){
+                name_search_consider(search, &matches, limit, match);
+            }
+        }
+
+        free(lowered_text);
+        return matches;
+    }
+
+    // Only names that contain every trigram of the text can contain the text,
+    // so the names of its rarest trigram are checked against the others
+    length_t trigrams_length = text_length - 2;
+    name_search_postings_t **postings = malloc(sizeof(name_search_postings_t*) * trigrams_length);
+    length_t *cursors = calloc(trigrams_length, sizeof(length_t));
+    length_t rarest = 0;
+
+    for(length_t i = 0; i != trigrams_length; i++){
+        postings[i] = search->postings ? &search->postings[name_search_trigram(&lowered_text[i])] : NULL;
+
+        if(postings[i] == NULL || postings[i]->length == 0){
+            goto cleanup;
+        }
+
+        if(postings[i]->length < postings[rarest]->length) rarest = i;
+    }
+
+    for(length_t i = 0; i != postings[rarest]->length; i++){
+        length_t id = postings[rarest]->names[i];
+        if(search->uses[id] == 0) continue;
+
+        bool has_all = true;
+
+        for(length_t j = 0; j != trigrams_length; j++){
+            if(j != rarest && !name_search_contains(postings[j], &cursors[j], id)){
+                has_all = false;
+                break;
+            }
+        }
+
+        name_search_match_t match = {.name = id};
+
+        // Having every trigram doesn't mean that they're in the right order
+        if(has_all && name_search_score(search, id, text, lowered_text, text_length, &match.score)){
+            name_search_consider(search, &matches, limit, match);
+        }
+    }
+
+cleanup:
+    free(postings);
+    free(cursors);
+    free(lowered_text);
+    return matches;
+}
@@ -0,0 +1,132 @@
+
+#include "project.h"
+
+#include <sys/stat.h>
+
+#include "UTIL/filename.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// ---------------- project_directory_t ----------------
+// The entry point found for files within a directory
+typedef struct {
+    strong_cstr_t path; // Includes trailing slash
+    maybe_null_strong_cstr_t entry;
+} project_directory_t;
+
+static project_directory_t *directories = NULL;
+static length_t directories_length = 0;
+static length_t directories_capacity = 0;
+static name_index_t directories_index;
+
+// Files that aren't imported by the entry points of their projects
+static strong_cstr_list_t excluded = {0};
+
+static project_directory_t *project_lookup(weak_cstr_t path){
+    if(directories_length == 0) return NULL;
+
+    length_t found = name_index_find(&directories_index, path);
+    return found == NAME_INDEX_NONE ? NULL : &directories[found];
+}
+
+static maybe_null_weak_cstr_t project_remember(strong_cstr_t path, maybe_null_strong_cstr_t entry){
+    // NOTE: Takes ownership of 'path' and 'entry'
+
+    if(directories_length == 0) name_index_init(&directories_index);
+
+    expand((void**) &directories, sizeof(project_directory_t), directories_length, &directories_capacity, 1, 16);
+
+    project_directory_t *directory = &directories[directories_length++];
+    directory->path = path;
+    directory->entry = entry;
+
+    // NOTE: Paths are never moved, so they can be borrowed by the index
+    name_index_add(&directories_index, directory->path);
+    return entry;
+}
+
+static bool project_is_repository_root(weak_cstr_t path){
+    strong_cstr_t git = mallocandsprintf("%s.git", path);
+
+    struct stat info;
+    bool exists = stat(git, &info) == 0;
+
+    free(git);
+    return exists;
+}
+
+static maybe_null_weak_cstr_t project_find_entry_from(strong_cstr_t path){
+    // Finds the entry point for files within a directory
+    // NOTE: Takes ownership of 'path'
+
+    project_directory_t *directory = project_lookup(path);
+
+    if(directory){
+        free(path);
+        return directory->entry;
+    }
+
+    strong_cstr_t entry = mallocandsprintf("%s%s", path, PROJECT_ENTRY_FILENAME);
+    if(file_exists(entry)) return project_remember(path, entry);
+
+    free(entry);
+
+    length_t path_length = strlen(path);
+    if(path_length <= 1 || project_is_repository_root(path)) return project_remember(path, NULL);
+
+    // Continue searching from the parent directory
+    path[path_length - 1] = '\0';
+    strong_cstr_t parent = filename_path(path);
+    path[path_length - 1] = '/';
+
+    if(parent[0] == '\0'){
+        free(parent);
+        return project_remember(path, NULL);
+    }
+
+    maybe_null_weak_cstr_t found = project_find_entry_from(parent);
+    return project_remember(path, found ? strclone(found) : NULL);
+}
+
+maybe_null_weak_cstr_t project_find_entry(weak_cstr_t absolute){
+    for(length_t i = 0; i != excluded.length; i++){
+        if(streq(excluded.items[i], absolute)) return NULL;
+    }
+
+    maybe_null_weak_cstr_t entry = project_find_entry_from(filename_path(absolute));
+
+    return entry && !streq(entry, absolute) ? entry : NULL;
+}
+
+void project_exclude(weak_cstr_t absolute){
+    strong_cstr_list_append(&excluded, strclone(absolute));
+}
+
+void project_file_changed(maybe_null_weak_cstr_t absolute, bool existence){
+    // Entry points can only appear or disappear when files are created or removed
+    if(absolute == NULL || existence){
+        for(length_t i = 0; i != directories_length; i++){
+            free(directories[i].path);
+            free(directories[i].entry);
+        }
+
+        if(directories_length != 0) name_index_free(&directories_index);
+        directories_length = 0;
+    }
+
+    // Changing any other file could make it start importing an excluded file
+    length_t kept = 0;
+
+    for(length_t i = 0; i != excluded.length; i++){
+        if(absolute && streq(excluded.items[i], absolute)){
+            excluded.items[kept++] = excluded.items[i];
+        } else {
+            free(excluded.items[i]);
+        }
+    }
+
+    excluded.length = kept;
+}
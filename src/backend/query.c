@@ -6,6 +6,7 @@
 #include "UTIL/jsmn_helper.h"
 #include "UTIL/util.h"
 #include "UTIL/string.h"
+#include "UTIL/string_list.h"
 
 void query_init(query_t *query){
     query->kind = QUERY_KIND_UNRECOGNIZED;
@@ -14,12 +15,19 @@ void query_init(query_t *query){
     query->code = NULL;
     query->warnings = true;
     query->features = QUERY_FEATURE_NONE;
+    query->files = (strong_cstr_list_t){0};
+    query->previous_result_id = NULL;
+    query->name = NULL;
+    query->has_range = false;
 }
 
 void query_free(query_t *query){
     free(query->filename);
     free(query->infrastructure);
     free(query->code);
+    strong_cstr_list_free(&query->files);
+    free(query->previous_result_id);
+    free(query->name);
 }
 
 successful_t query_parse(weak_cstr_t json, query_t *out_query, strong_cstr_t *out_error){
@@ -109,6 +117,10 @@ successful_t query_parse(weak_cstr_t json, query_t *out_query, strong_cstr_t *ou
                     features |= QUERY_FEATURE_INCLUDE_ARG_INFO;
                 } else if(streq(content, "include-calls")){
                     features |= QUERY_FEATURE_INCLUDE_CALLS;
+                } else if(streq(content, "project")){
+                    features |= QUERY_FEATURE_PROJECT;
+                } else if(streq(content, "match-prefix")){
+                    features |= QUERY_FEATURE_MATCH_PREFIX;
                 } else {
                     *out_error = mallocandsprintf("Unsupported feature '%s'", content);
                     free(content);
@@ -119,6 +131,84 @@ successful_t query_parse(weak_cstr_t json, query_t *out_query, strong_cstr_t *ou
             }
 
             out_query->features = features;
+
+            // Already advanced past the array
+            continue;
+        } else if(jsmnh_obj_ctx_eq(&ctx, "previousResultId")){
+            // "previousResultId" : "..."
+            if(!jsmnh_obj_ctx_get_variable_string(&ctx, &out_query->previous_result_id)){
+                *out_error = mallocandsprintf("Expected string value for '%s'", ctx.value.content);
+                goto failure;
+            }
+        } else if(jsmnh_obj_ctx_eq(&ctx, "name")){
+            // "name" : "..."
+            if(!jsmnh_obj_ctx_get_variable_string(&ctx, &out_query->name)){
+                *out_error = mallocandsprintf("Expected string value for '%s'", ctx.value.content);
+                goto failure;
+            }
+        } else if(jsmnh_obj_ctx_eq(&ctx, "range")){
+            // "range" : [startLine, startCharacter, endLine, endCharacter]
+            // "range" : null
+
+            jsmntok_t value_token = ctx.tokens.tokens[ctx.token_index];
+            if(value_token.type == JSMN_PRIMITIVE && ctx.fulltext.content[value_token.start] == 'n'){
+                out_query->has_range = false;
+                jsmnh_obj_ctx_blind_advance(&ctx);
+                continue;
+            }
+
+            if(!jsmnh_obj_ctx_get_array(&ctx) || ctx.tokens.tokens[ctx.token_index].size != 4){
+                *out_error = mallocandsprintf("Expected array of four integers for '%s'", ctx.value.content);
+                goto failure;
+            }
+
+            ctx.token_index++;
+
+            length_t *fields[4] = {
+                &out_query->range_start_line,
+                &out_query->range_start_character,
+                &out_query->range_end_line,
+                &out_query->range_end_character,
+            };
+
+            for(length_t i = 0; i != 4; i++){
+                long long value;
+                if(!jsmnh_obj_ctx_get_integer(&ctx, &value) || value < 0){
+                    *out_error = mallocandsprintf("Expected non-negative integer in range array");
+                    goto failure;
+                }
+
+                ctx.token_index++;
+                *fields[i] = value;
+            }
+
+            out_query->has_range = true;
+
+            // Already advanced past the array
+            continue;
+        } else if(jsmnh_obj_ctx_eq(&ctx, "files")){
+            // "files" : [...]
+
+            if(!jsmnh_obj_ctx_get_array(&ctx)){
+                *out_error = mallocandsprintf("Expected array value for '%s'", ctx.value.content);
+                goto failure;
+            }
+
+            length_t count = ctx.tokens.tokens[ctx.token_index++].size;
+
+            for(length_t i = 0; i < count; i++){
+                strong_cstr_t file;
+                if(!jsmnh_obj_ctx_get_variable_string(&ctx, &file)){
+                    *out_error = mallocandsprintf("Expected a filename string in files array");
+                    goto failure;
+                }
+
+                ctx.token_index++;
+                strong_cstr_list_append(&out_query->files, file);
+            }
+
+            // Already advanced past the array
+            continue;
         } else {
             // "???" : "???"
             if(out_error) *out_error = mallocandsprintf("Unrecognized key '%s'", ctx.value.content);
@@ -148,6 +238,86 @@ successful_t query_set_kind_by_name(query_t *out_query, weak_cstr_t kind_name){
         return true;
     }
 
+    if(streq(kind_name, "files-changed")){
+        out_query->kind = QUERY_KIND_FILES_CHANGED;
+        return true;
+    }
+
+    if(streq(kind_name, "buffer-closed")){
+        out_query->kind = QUERY_KIND_BUFFER_CLOSED;
+        return true;
+    }
+
+    if(streq(kind_name, "dependents")){
+        out_query->kind = QUERY_KIND_DEPENDENTS;
+        return true;
+    }
+
+    if(streq(kind_name, "semantic-tokens")){
+        out_query->kind = QUERY_KIND_SEMANTIC_TOKENS;
+        return true;
+    }
+
+    if(streq(kind_name, "inlay-hints")){
+        out_query->kind = QUERY_KIND_INLAY_HINTS;
+        return true;
+    }
+
+    if(streq(kind_name, "document-symbols")){
+        out_query->kind = QUERY_KIND_DOCUMENT_SYMBOLS;
+        return true;
+    }
+
+    if(streq(kind_name, "references")){
+        out_query->kind = QUERY_KIND_REFERENCES;
+        return true;
+    }
+
+    if(streq(kind_name, "call-hierarchy")){
+        out_query->kind = QUERY_KIND_CALL_HIERARCHY;
+        return true;
+    }
+
+    if(streq(kind_name, "incoming-calls")){
+        out_query->kind = QUERY_KIND_INCOMING_CALLS;
+        return true;
+    }
+
+    if(streq(kind_name, "outgoing-calls")){
+        out_query->kind = QUERY_KIND_OUTGOING_CALLS;
+        return true;
+    }
+
+    if(streq(kind_name, "signature-help")){
+        out_query->kind = QUERY_KIND_SIGNATURE_HELP;
+        return true;
+    }
+
+    if(streq(kind_name, "symbols")){
+        out_query->kind = QUERY_KIND_SYMBOLS;
+        return true;
+    }
+
+    if(streq(kind_name, "index-workspace")){
+        out_query->kind = QUERY_KIND_INDEX_WORKSPACE;
+        return true;
+    }
+
+    if(streq(kind_name, "workspace-symbols")){
+        out_query->kind = QUERY_KIND_WORKSPACE_SYMBOLS;
+        return true;
+    }
+
+    if(streq(kind_name, "folding-ranges")){
+        out_query->kind = QUERY_KIND_FOLDING_RANGES;
+        return true;
+    }
+
+    if(streq(kind_name, "selection-ranges")){
+        out_query->kind = QUERY_KIND_SELECTION_RANGES;
+        return true;
+    }
+
     return false;
 }
 
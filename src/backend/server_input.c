@@ -0,0 +1,27 @@
+
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#include "server_input.h"
+
+extern void server_input_unbuffered(void){
+    setvbuf(stdin, NULL, _IONBF, 0);
+}
+
+extern bool server_input_pending(void){
+    #if defined(__unix__) || defined(__APPLE__)
+    struct pollfd descriptor = {
+        .fd = STDIN_FILENO,
+        .events = POLLIN,
+    };
+
+    // Errors and hang ups are left for the next read to report
+    return poll(&descriptor, 1, 0) != 0;
+    #else
+    return true;
+    #endif
+}
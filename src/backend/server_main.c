@@ -10,6 +10,19 @@
 
 #include "ValidationQuery.h"
 #include "ASTQuery.h"
+#include "FilesChangedQuery.h"
+#include "BufferClosedQuery.h"
+#include "DependentsQuery.h"
+#include "SemanticTokensQuery.h"
+#include "InlayHintsQuery.h"
+#include "DocumentSymbolsQuery.h"
+#include "ReferencesQuery.h"
+#include "CallHierarchyQuery.h"
+#include "SignatureHelpQuery.h"
+#include "SymbolsQuery.h"
+#include "IndexWorkspaceQuery.h"
+#include "FoldingRangesQuery.h"
+#include "workspace_index.h"
 
 extern strong_cstr_t server_main(weak_cstr_t query_json){
     json_builder_t builder;
@@ -22,7 +35,10 @@ extern strong_cstr_t server_main(weak_cstr_t query_json){
         free(error_message);
         return json_builder_finalize(&builder);
     }
-    
+
+    // Background indexing of the workspace waits while queries are handled
+    workspace_index_pause();
+
     switch(query.kind){
     case QUERY_KIND_VALIDATE:
         handle_validation_query(&query, &builder);
@@ -30,12 +46,61 @@ extern strong_cstr_t server_main(weak_cstr_t query_json){
     case QUERY_KIND_AST:
         handle_ast_query(&query, &builder);
         break;
+    case QUERY_KIND_FILES_CHANGED:
+        handle_files_changed_query(&query, &builder);
+        break;
+    case QUERY_KIND_BUFFER_CLOSED:
+        handle_buffer_closed_query(&query, &builder);
+        break;
+    case QUERY_KIND_DEPENDENTS:
+        handle_dependents_query(&query, &builder);
+        break;
+    case QUERY_KIND_SEMANTIC_TOKENS:
+        handle_semantic_tokens_query(&query, &builder);
+        break;
+    case QUERY_KIND_INLAY_HINTS:
+        handle_inlay_hints_query(&query, &builder);
+        break;
+    case QUERY_KIND_DOCUMENT_SYMBOLS:
+        handle_document_symbols_query(&query, &builder);
+        break;
+    case QUERY_KIND_REFERENCES:
+        handle_references_query(&query, &builder);
+        break;
+    case QUERY_KIND_CALL_HIERARCHY:
+        handle_call_hierarchy_query(&query, &builder);
+        break;
+    case QUERY_KIND_INCOMING_CALLS:
+        handle_incoming_calls_query(&query, &builder);
+        break;
+    case QUERY_KIND_OUTGOING_CALLS:
+        handle_outgoing_calls_query(&query, &builder);
+        break;
+    case QUERY_KIND_SIGNATURE_HELP:
+        handle_signature_help_query(&query, &builder);
+        break;
+    case QUERY_KIND_SYMBOLS:
+        handle_symbols_query(&query, &builder);
+        break;
+    case QUERY_KIND_INDEX_WORKSPACE:
+        handle_index_workspace_query(&query, &builder);
+        break;
+    case QUERY_KIND_WORKSPACE_SYMBOLS:
+        handle_workspace_symbols_query(&query, &builder);
+        break;
+    case QUERY_KIND_FOLDING_RANGES:
+        handle_folding_ranges_query(&query, &builder);
+        break;
+    case QUERY_KIND_SELECTION_RANGES:
+        handle_selection_ranges_query(&query, &builder);
+        break;
     default:
         json_build_string(&builder, "Query kind is missing or unrecognized");
         goto cleanup_and_finalize;
     }
 
 cleanup_and_finalize:
+    workspace_index_resume();
     query_free(&query);
     return json_builder_finalize(&builder);
 }
@@ -0,0 +1,331 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "signature_table.h"
+#include "json_builder.h"
+#include "json_builder_ex.h"
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "AST/TYPE/ast_type_hash.h"
+#include "DRVR/object.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// ---------------- signature_file_t ----------------
+// The signatures of the functions declared within a file
+typedef struct {
+    strong_cstr_t absolute;
+    signature_t **signatures; // Open-addressed by version
+    length_t capacity;
+    length_t used;
+} signature_file_t;
+
+// ---------------- signature_document_t ----------------
+// The overload sets of a document, which borrow their signatures
+typedef struct {
+    strong_cstr_t absolute;
+    signature_t **overloads;
+    length_t length;
+    length_t capacity;
+    name_index_t index;
+} signature_document_t;
+
+static signature_file_t *files = NULL;
+static length_t files_length = 0;
+static length_t files_capacity = 0;
+static name_index_t files_index;
+
+static signature_document_t *documents = NULL;
+static length_t documents_length = 0;
+static length_t documents_capacity = 0;
+static name_index_t documents_index;
+
+// Number of times that the table has been updated
+static length_t generation = 0;
+
+static hash_t signature_version(compiler_t *compiler, ast_func_t *func){
+    hash_t version = hash_data(func->name, strlen(func->name));
+
+    // The text of the head of the function covers names and default values,
+    // and the types cover what the names within them refer to
+    object_t *object = func->source.object_index < compiler->objects_length ? compiler->objects[func->source.object_index] : NULL;
+
+    if(object && object->buffer && func->source.stride != 0 && func->source.index < object->buffer_length){
+        length_t begin = func->source.index;
+        length_t end = object->buffer_length;
+
+        if(func->body_token_index != 0 && func->body_token_index < object->tokenlist.length){
+            end = object->tokenlist.sources[func->body_token_index].index;
+        } else {
+            const char *newline = memchr(&object->buffer[begin], '\n', object->buffer_length - begin);
+            if(newline) end = newline - object->buffer;
+        }
+
+        if(end > begin && end <= object->buffer_length){
+            version = hash_combine(version, hash_data(&object->buffer[begin], end - begin));
+        }
+    }
+
+    for(length_t i = 0; i != func->arity; i++){
+        if(func->arg_names && func->arg_names[i]){
+            version = hash_combine(version, hash_data(func->arg_names[i], strlen(func->arg_names[i])));
+        }
+
+        version = hash_combine(version, ast_type_hash(&func->arg_types[i]));
+    }
+
+    version = hash_combine(version, ast_type_hash(&func->return_type));
+    return hash_combine(version, func->traits & (AST_FUNC_VARARG | AST_FUNC_VARIADIC));
+}
+
+static signature_t *signature_format(ast_func_t *func, hash_t version){
+    signature_t *signature = malloc(sizeof(signature_t));
+
+    *signature = (signature_t){
+        .version = version,
+        .name = strclone(func->name),
+        .params = func->arity ? malloc(sizeof(signature_param_t) * func->arity) : NULL,
+        .arity = func->arity,
+        .is_variadic = func->traits & (AST_FUNC_VARARG | AST_FUNC_VARIADIC),
+    };
+
+    string_builder_t label;
+    string_builder_init(&label);
+    string_builder_append(&label, func->name);
+    string_builder_append_char(&label, '(');
+
+    for(length_t i = 0; i != func->arity; i++){
+        signature_param_t *param = &signature->params[i];
+
+        if(i != 0) string_builder_append(&label, ", ");
+        param->label_begin = label.length;
+
+        param->name = func->arg_names && func->arg_names[i] ? strclone(func->arg_names[i]) : NULL;
+        param->type = ast_type_str(&func->arg_types[i]);
+        param->default_value = func->arg_defaults && func->arg_defaults[i] ? ast_expr_str(func->arg_defaults[i]) : NULL;
+
+        if(param->name){
+            string_builder_append(&label, param->name);
+            string_builder_append_char(&label, ' ');
+        }
+
+        if(func->arg_type_traits && func->arg_type_traits[i] & AST_FUNC_ARG_TYPE_TRAIT_POD){
+            string_builder_append(&label, "POD ");
+        }
+
+        string_builder_append(&label, param->type);
+
+        if(param->default_value){
+            string_builder_append(&label, " = ");
+            string_builder_append(&label, param->default_value);
+        }
+
+        param->label_end = label.length;
+    }
+
+    if(func->traits & AST_FUNC_VARARG){
+        string_builder_append(&label, func->arity ? ", ..." : "...");
+    } else if(func->traits & AST_FUNC_VARIADIC){
+        if(func->arity) string_builder_append(&label, ", ");
+        string_builder_append(&label, func->variadic_arg_name);
+        string_builder_append(&label, " ...");
+    }
+
+    string_builder_append(&label, ") ");
+
+    strong_cstr_t return_type = ast_type_str(&func->return_type);
+    string_builder_append(&label, return_type);
+    free(return_type);
+
+    signature->label = string_builder_finalize(&label);
+
+    json_builder_t definition;
+    json_builder_init(&definition);
+    json_build_func_definition(&definition, func);
+    signature->definition = json_builder_finalize(&definition);
+    return signature;
+}
+
+static void signature_free(signature_t *signature){
+    for(length_t i = 0; i != signature->arity; i++){
+        signature_param_t *param = &signature->params[i];
+        free(param->name);
+        free(param->type);
+        free(param->default_value);
+    }
+
+    free(signature->params);
+    free(signature->name);
+    free(signature->label);
+    free(signature->definition);
+    free(signature);
+}
+
+static signature_file_t *signature_file(weak_cstr_t absolute){
+    if(files == NULL) name_index_init(&files_index);
+
+    length_t found = name_index_find(&files_index, absolute);
+    if(found != NAME_INDEX_NONE) return &files[found];
+
+    expand((void**) &files, sizeof(signature_file_t), files_length, &files_capacity, 1, 16);
+    signature_file_t *file = &files[files_length];
+    *file = (signature_file_t){ .absolute = strclone(absolute) };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&files_index, file->absolute);
+    files_length++;
+    return file;
+}
+
+static signature_t **signature_slot(signature_file_t *file, hash_t version, weak_cstr_t name, length_t arity){
+    // Finds the slot of a signature, or the empty slot where it belongs
+    length_t mask = file->capacity - 1;
+
+    for(length_t i = version & mask;; i = (i + 1) & mask){
+        signature_t *signature = file->signatures[i];
+
+        if(signature == NULL) return &file->signatures[i];
+        if(signature->version == version && signature->arity == arity && streq(signature->name, name)) return &file->signatures[i];
+    }
+}
+
+static void signature_rehash(signature_file_t *file, length_t capacity, bool evict){
+    // Moves the signatures of a file into a table of the given capacity,
+    // dropping ones that are stale when evicting
+    signature_t **old_signatures = file->signatures;
+    length_t old_capacity = file->capacity;
+
+    file->signatures = calloc(capacity, sizeof(signature_t*));
+    file->capacity = capacity;
+    file->used = 0;
+
+    for(length_t i = 0; i != old_capacity; i++){
+        signature_t *signature = old_signatures[i];
+        if(signature == NULL) continue;
+
+        if(evict && signature->generation != generation && signature->references == 0){
+            signature_free(signature);
+            continue;
+        }
+
+        *signature_slot(file, signature->version, signature->name, signature->arity) = signature;
+        file->used++;
+    }
+
+    free(old_signatures);
+}
+
+static weak_cstr_t signature_func_file(compiler_t *compiler, ast_func_t *func){
+    object_t *object = func->source.object_index < compiler->objects_length ? compiler->objects[func->source.object_index] : NULL;
+    return object && object->full_filename ? object->full_filename : "";
+}
+
+signature_t *signature_get(compiler_t *compiler, ast_func_t *func){
+    hash_t version = signature_version(compiler, func);
+    signature_file_t *file = signature_file(signature_func_file(compiler, func));
+
+    if(file->signatures){
+        signature_t *existing = *signature_slot(file, version, func->name, func->arity);
+
+        if(existing){
+            existing->generation = generation;
+            return existing;
+        }
+    }
+
+    // Keep the table at most half full
+    if((file->used + 1) * 2 > file->capacity) signature_rehash(file, file->capacity ? file->capacity * 2 : 64, false);
+
+    signature_t *signature = signature_format(func, version);
+    signature->generation = generation;
+    *signature_slot(file, version, func->name, func->arity) = signature;
+    file->used++;
+
+    return signature;
+}
+
+static signature_document_t *signature_find_document(weak_cstr_t absolute){
+    if(documents == NULL) return NULL;
+
+    length_t found = name_index_find(&documents_index, absolute);
+    return found != NAME_INDEX_NONE ? &documents[found] : NULL;
+}
+
+void signature_table_update(weak_cstr_t absolute, compiler_t *compiler, ast_t *ast){
+    if(absolute == NULL || absolute[0] == '\0') return;
+
+    generation++;
+
+    signature_t **overloads = malloc(sizeof(signature_t*) * (ast->funcs_length ? ast->funcs_length : 1));
+    length_t overloads_length = 0;
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        // Generated functions can't be called by name
+        if(ast->funcs[i].source.stride == 0) continue;
+
+        signature_t *signature = signature_get(compiler, &ast->funcs[i]);
+        signature->references++;
+        overloads[overloads_length++] = signature;
+    }
+
+    signature_document_t *document = signature_find_document(absolute);
+
+    if(document == NULL){
+        if(documents == NULL) name_index_init(&documents_index);
+
+        expand((void**) &documents, sizeof(signature_document_t), documents_length, &documents_capacity, 1, 16);
+        document = &documents[documents_length];
+        *document = (signature_document_t){ .absolute = strclone(absolute) };
+
+        // NOTE: Filenames are never moved, so they can be borrowed by the index
+        name_index_add(&documents_index, document->absolute);
+        documents_length++;
+    } else {
+        for(length_t i = 0; i != document->length; i++){
+            document->overloads[i]->references--;
+        }
+
+        free(document->overloads);
+        name_index_free(&document->index);
+    }
+
+    document->overloads = overloads;
+    document->length = overloads_length;
+    document->capacity = overloads_length;
+
+    // NOTE: Signatures are kept while they're borrowed, so their names can be borrowed by the index
+    name_index_init(&document->index);
+
+    for(length_t i = 0; i != overloads_length; i++){
+        name_index_add(&document->index, overloads[i]->name);
+    }
+
+    // Forget versions of the compiled files that are no longer used by any document
+    for(length_t i = 0; i != compiler->objects_length; i++){
+        weak_cstr_t filename = compiler->objects[i]->full_filename;
+        length_t found = files ? name_index_find(&files_index, filename ? filename : "") : NAME_INDEX_NONE;
+
+        if(found != NAME_INDEX_NONE){
+            signature_file_t *file = &files[found];
+            signature_rehash(file, file->capacity, true);
+        }
+    }
+}
+
+signature_list_t signature_table_find(weak_cstr_t absolute, weak_cstr_t name){
+    signature_list_t list = {0};
+
+    signature_document_t *document = signature_find_document(absolute);
+    if(document == NULL) return list;
+
+    for(length_t i = name_index_find(&document->index, name); i != NAME_INDEX_NONE; i = name_index_next(&document->index, i)){
+        list_append(&list, document->overloads[i], signature_t*);
+    }
+
+    return list;
+}
@@ -0,0 +1,898 @@
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if !__EMSCRIPTEN__ && !defined(_WIN32) && !defined(_WIN64)
+#define SYMBOL_INDEX_MAP_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <direct.h>
+#endif
+
+#include "symbol_index.h"
+#include "json_builder.h"
+#include "json_builder_ex.h"
+#include "line_index.h"
+#include "name_search.h"
+#include "signature_table.h"
+
+#include "DRVR/object.h"
+#include "DRVR/overlay.h"
+#include "UTIL/hash.h"
+#include "UTIL/name_index.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+/*
+    Layout of a cache file, in the byte order of the machine that wrote it:
+
+    symbol_index_header_t
+    symbol_index_file_record_t   [files_length]
+    symbol_index_record_t        [symbols_length]
+    char                         [strings_length]   (null-terminated strings)
+
+    Every section begins on an 8 byte boundary, and strings are referred
+    to by their offset into the string pool, where offset zero is "".
+*/
+
+#define SYMBOL_INDEX_MAGIC "ADEPTSYM"
+#define SYMBOL_INDEX_FORMAT_VERSION 2
+#define SYMBOL_INDEX_BYTE_ORDER 0x01020304
+
+// Least number of seconds between writes of the cache file
+#define SYMBOL_INDEX_SAVE_INTERVAL 30
+
+// ---------------- symbol_index_header_t ----------------
+// Beginning of a cache file
+typedef struct {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t byte_order;
+    uint64_t infrastructure;
+    uint64_t compiler_version;
+    uint64_t files_length;
+    uint64_t symbols_length;
+    uint64_t strings_length;
+    uint64_t reserved;
+} symbol_index_header_t;
+
+// ---------------- symbol_index_file_record_t ----------------
+// An indexed file within a cache file
+typedef struct {
+    uint64_t filename;
+    uint64_t hash;
+    uint64_t buffer_length;
+    uint64_t first_symbol;
+    uint64_t symbols_length;
+    uint64_t flags;
+} symbol_index_file_record_t;
+
+// Declarations of the file were found without compiling it
+#define SYMBOL_INDEX_FILE_SHALLOW 0x1
+
+// ---------------- symbol_index_record_t ----------------
+// A declaration within a cache file, or within a file indexed since it was loaded
+typedef struct {
+    uint64_t name;
+    uint64_t definition;
+    uint32_t kind;
+    uint32_t line;
+    uint32_t character;
+    uint32_t reserved;
+} symbol_index_record_t;
+
+// ---------------- symbol_index_pool_t ----------------
+// Growable pool of null-terminated strings
+typedef struct {
+    char *chars;
+    length_t length;
+    length_t capacity;
+} symbol_index_pool_t;
+
+// ---------------- symbol_index_file_t ----------------
+// The declarations of a file, which either borrow from the mapped cache file or are owned
+typedef struct {
+    strong_cstr_t absolute;
+    text_version_t version;
+    bool is_owned;
+    bool is_shallow;
+    const symbol_index_record_t *records;
+    length_t records_length;
+    const char *strings;
+    length_t strings_length;
+
+    // Searchable name of each declaration, or NULL until the file is first searched
+    length_t *names;
+} symbol_index_file_t;
+
+// ---------------- symbol_index_build_t ----------------
+// Declarations found so far for a file that is being indexed again
+typedef struct {
+    length_t file;
+    text_version_t version;
+    line_index_t lines;
+    symbol_index_record_t *records;
+    length_t records_length;
+    length_t records_capacity;
+    symbol_index_pool_t pool;
+} symbol_index_build_t;
+
+// ---------------- symbol_index_ranked_t ----------------
+// A declaration that was found by searching, and the rank of its name
+typedef struct {
+    length_t rank;
+    length_t file;
+    length_t record;
+} symbol_index_ranked_t;
+
+// ---------------- symbol_index_writer_t ----------------
+// The string pool of a cache file that is being written,
+// where each distinct string is only stored once
+typedef struct {
+    symbol_index_pool_t pool;
+    name_index_t strings_index;
+    length_t *offsets;
+    length_t offsets_length;
+    length_t offsets_capacity;
+} symbol_index_writer_t;
+
+static strong_cstr_t infrastructure = NULL;
+static strong_cstr_t cache_filename = NULL;
+
+// Mapped cache file, which is kept for as long as files borrow from it
+static const char *mapping = NULL;
+static length_t mapping_length = 0;
+
+static symbol_index_file_t *files = NULL;
+static length_t files_length = 0;
+static length_t files_capacity = 0;
+static name_index_t files_index;
+
+static bool is_dirty = false;
+static time_t last_saved = 0;
+
+// Names of every declaration, which are only interned once something is searched for
+static name_search_t names;
+static bool is_searchable = false;
+
+// Rank of each name within the current search results, or NAME_INDEX_NONE
+static length_t *name_ranks = NULL;
+static length_t name_ranks_capacity = 0;
+
+static length_t symbol_index_pool_add(symbol_index_pool_t *pool, weak_cstr_t string){
+    if(pool->length == 0){
+        // Offset zero is always ""
+        expand((void**) &pool->chars, sizeof(char), pool->length, &pool->capacity, 1, 4096);
+        pool->chars[pool->length++] = '\0';
+    }
+
+    if(string == NULL || string[0] == '\0') return 0;
+
+    length_t size = strlen(string) + 1;
+    length_t offset = pool->length;
+
+    expand((void**) &pool->chars, sizeof(char), pool->length, &pool->capacity, size, 4096);
+    memcpy(&pool->chars[offset], string, size);
+    pool->length += size;
+    return offset;
+}
+
+static weak_cstr_t symbol_index_string(const char *strings, length_t strings_length, uint64_t offset){
+    // Strings of cache files are checked when they're used, so loading doesn't have to touch them
+    return offset < strings_length ? (weak_cstr_t) &strings[offset] : "";
+}
+
+static symbol_index_file_t *symbol_index_find_file(weak_cstr_t absolute){
+    if(files == NULL) return NULL;
+
+    length_t found = name_index_find(&files_index, absolute);
+    return found != NAME_INDEX_NONE ? &files[found] : NULL;
+}
+
+static symbol_index_file_t *symbol_index_file(weak_cstr_t absolute){
+    symbol_index_file_t *file = symbol_index_find_file(absolute);
+    if(file) return file;
+
+    if(files == NULL) name_index_init(&files_index);
+
+    expand((void**) &files, sizeof(symbol_index_file_t), files_length, &files_capacity, 1, 256);
+
+    files[files_length] = (symbol_index_file_t){
+        .absolute = strclone(absolute),
+    };
+
+    // NOTE: Filenames are never moved, so they can be borrowed by the index
+    name_index_add(&files_index, files[files_length].absolute);
+    return &files[files_length++];
+}
+
+static void symbol_index_file_clear(symbol_index_file_t *file){
+    if(file->names){
+        for(length_t i = 0; i != file->records_length; i++){
+            name_search_release(&names, file->names[i]);
+        }
+
+        free(file->names);
+        file->names = NULL;
+    }
+
+    if(file->is_owned){
+        free((void*) file->records);
+        free((void*) file->strings);
+    }
+
+    file->version = (text_version_t){0};
+    file->is_owned = false;
+    file->is_shallow = false;
+    file->records = NULL;
+    file->records_length = 0;
+    file->strings = NULL;
+    file->strings_length = 0;
+}
+
+static void symbol_index_close(void){
+    for(length_t i = 0; i != files_length; i++){
+        symbol_index_file_clear(&files[i]);
+        free(files[i].absolute);
+    }
+
+    if(files) name_index_free(&files_index);
+    free(files);
+    files = NULL;
+    files_length = 0;
+    files_capacity = 0;
+
+    #ifdef SYMBOL_INDEX_MAP_SUPPORTED
+    if(mapping) munmap((void*) mapping, mapping_length);
+    #else
+    free((void*) mapping);
+    #endif
+
+    mapping = NULL;
+    mapping_length = 0;
+
+    if(is_searchable) name_search_free(&names);
+    free(name_ranks);
+    is_searchable = false;
+    name_ranks = NULL;
+    name_ranks_capacity = 0;
+
+    free(infrastructure);
+    free(cache_filename);
+    infrastructure = NULL;
+    cache_filename = NULL;
+    is_dirty = false;
+    last_saved = 0;
+}
+
+static void symbol_index_save_when_due(void){
+    // The cache file is written as soon as it's first out of date, and then at most every so often,
+    // which keeps rapid edits to open files from rewriting it constantly
+    if(difftime(time(NULL), last_saved) >= SYMBOL_INDEX_SAVE_INTERVAL){
+        symbol_index_save();
+    }
+}
+
+static void symbol_index_make_directory(weak_cstr_t path){
+    #if defined(_WIN32) || defined(_WIN64)
+    mkdir(path);
+    #else
+    mkdir(path, 0755);
+    #endif
+}
+
+static strong_cstr_t symbol_index_cache_filename(weak_cstr_t infrastructure){
+    weak_cstr_t cache_home = getenv("XDG_CACHE_HOME");
+    weak_cstr_t home = getenv("HOME");
+    if(home == NULL) home = getenv("LOCALAPPDATA");
+
+    strong_cstr_t directory;
+
+    if(cache_home && cache_home[0] != '\0'){
+        symbol_index_make_directory(cache_home);
+        directory = mallocandsprintf("%s/adept-insight", cache_home);
+    } else if(home && home[0] != '\0'){
+        strong_cstr_t parent = mallocandsprintf("%s/.cache", home);
+        symbol_index_make_directory(parent);
+        free(parent);
+
+        directory = mallocandsprintf("%s/.cache/adept-insight", home);
+    } else {
+        return NULL;
+    }
+
+    symbol_index_make_directory(directory);
+
+    // Each infrastructure and compiler version has a separate cache file
+    char key[32];
+    snprintf(key, sizeof key, "%016llx", (unsigned long long) hash_data(infrastructure, strlen(infrastructure)));
+
+    strong_cstr_t filename = mallocandsprintf("%s/%s-%s.symbols", directory, key, ADEPT_VERSION_STRING);
+    free(directory);
+    return filename;
+}
+
+static bool symbol_index_read(weak_cstr_t filename, const char **out_contents, length_t *out_length){
+    #ifdef SYMBOL_INDEX_MAP_SUPPORTED
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if(fd == -1) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size < (off_t) sizeof(symbol_index_header_t)){
+        close(fd);
+        return false;
+    }
+
+    // Cache files are only ever replaced and never written in place,
+    // so a shared mapping stays valid, and its pages are shared between servers
+    void *contents = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(contents == MAP_FAILED) return false;
+
+    *out_contents = contents;
+    *out_length = info.st_size;
+    return true;
+    #else
+    strong_cstr_t contents;
+    if(!file_binary_contents(filename, &contents, out_length)) return false;
+
+    *out_contents = contents;
+    return true;
+    #endif
+}
+
+static bool symbol_index_load(weak_cstr_t infrastructure, const char *contents, length_t length){
+    const symbol_index_header_t *header = (const symbol_index_header_t*) contents;
+
+    if(length < sizeof(symbol_index_header_t)
+    || memcmp(header->magic, SYMBOL_INDEX_MAGIC, sizeof header->magic) != 0
+    || header->format_version != SYMBOL_INDEX_FORMAT_VERSION
+    || header->byte_order != SYMBOL_INDEX_BYTE_ORDER){
+        return false;
+    }
+
+    uint64_t available = length - sizeof(symbol_index_header_t);
+
+    if(header->files_length > available / sizeof(symbol_index_file_record_t)) return false;
+    available -= header->files_length * sizeof(symbol_index_file_record_t);
+
+    if(header->symbols_length > available / sizeof(symbol_index_record_t)) return false;
+    available -= header->symbols_length * sizeof(symbol_index_record_t);
+
+    if(header->strings_length == 0 || header->strings_length > available) return false;
+
+    const symbol_index_file_record_t *file_records = (const symbol_index_file_record_t*) &contents[sizeof(symbol_index_header_t)];
+    const symbol_index_record_t *records = (const symbol_index_record_t*) &file_records[header->files_length];
+    const char *strings = (const char*) &records[header->symbols_length];
+    length_t strings_length = header->strings_length;
+
+    // Every string is terminated, as long as the pool is
+    if(strings[strings_length - 1] != '\0') return false;
+
+    if(!streq(symbol_index_string(strings, strings_length, header->infrastructure), infrastructure)
+    || !streq(symbol_index_string(strings, strings_length, header->compiler_version), ADEPT_VERSION_STRING)){
+        return false;
+    }
+
+    for(length_t i = 0; i != header->files_length; i++){
+        const symbol_index_file_record_t *record = &file_records[i];
+
+        if(record->first_symbol > header->symbols_length || record->symbols_length > header->symbols_length - record->first_symbol) continue;
+
+        weak_cstr_t absolute = symbol_index_string(strings, strings_length, record->filename);
+        if(absolute[0] == '\0' || symbol_index_find_file(absolute)) continue;
+
+        symbol_index_file_t *file = symbol_index_file(absolute);
+        file->version = text_version(record->hash, record->buffer_length);
+        file->is_owned = false;
+        file->is_shallow = record->flags & SYMBOL_INDEX_FILE_SHALLOW;
+        file->records = &records[record->first_symbol];
+        file->records_length = record->symbols_length;
+        file->strings = strings;
+        file->strings_length = strings_length;
+    }
+
+    return true;
+}
+
+void symbol_index_open(weak_cstr_t infrastructure_path){
+    if(infrastructure && streq(infrastructure, infrastructure_path)) return;
+
+    if(infrastructure){
+        symbol_index_save();
+        symbol_index_close();
+    }
+
+    infrastructure = strclone(infrastructure_path);
+    cache_filename = symbol_index_cache_filename(infrastructure_path);
+
+    const char *contents;
+    length_t length;
+
+    if(cache_filename && symbol_index_read(cache_filename, &contents, &length)){
+        mapping = contents;
+        mapping_length = length;
+
+        if(!symbol_index_load(infrastructure_path, contents, length)){
+            // Cache files of other versions are ignored, and replaced when the index is next saved
+            symbol_index_close();
+            infrastructure = strclone(infrastructure_path);
+            cache_filename = symbol_index_cache_filename(infrastructure_path);
+        }
+    }
+}
+
+static bool symbol_index_is_building(symbol_index_build_t *builds, length_t builds_length, object_t **objects, source_t source){
+    // Declarations without a source, such as those that are built in, aren't indexed
+    return source.stride != 0 && source.object_index < builds_length && builds[source.object_index].file != NAME_INDEX_NONE && source.index < objects[source.object_index]->buffer_length;
+}
+
+static void symbol_index_add(symbol_index_build_t *build, source_t source, symbol_kind_t kind, weak_cstr_t name, json_builder_t *definition){
+    // NOTE: Takes ownership of 'definition'
+    strong_cstr_t formatted = json_builder_finalize(definition);
+
+    length_t line, character;
+    line_index_position(&build->lines, source.index, &line, &character);
+
+    expand((void**) &build->records, sizeof(symbol_index_record_t), build->records_length, &build->records_capacity, 1, 64);
+
+    build->records[build->records_length++] = (symbol_index_record_t){
+        .name = symbol_index_pool_add(&build->pool, name),
+        .definition = symbol_index_pool_add(&build->pool, formatted),
+        .kind = kind,
+        .line = line,
+        .character = character,
+    };
+
+    free(formatted);
+}
+
+void symbol_index_update(compiler_t *compiler, ast_t *ast){
+    if(infrastructure == NULL) return;
+
+    length_t objects_length = compiler->objects_length;
+    object_t **objects = compiler->objects;
+    symbol_index_build_t *builds = calloc(objects_length, sizeof(symbol_index_build_t));
+    bool has_changed = false;
+
+    for(length_t i = 0; i != objects_length; i++){
+        object_t *object = objects[i];
+        builds[i].file = NAME_INDEX_NONE;
+
+        if(object->full_filename == NULL || object->full_filename[0] == '\0' || object->buffer == NULL) continue;
+
+        // Most files, such as those of the standard library, are already indexed
+        text_version_t version = text_version(object->buffer_hash, object->buffer_length);
+        symbol_index_file_t *existing = symbol_index_find_file(object->full_filename);
+        if(existing && !existing->is_shallow && text_version_is_current(&existing->version, version)) continue;
+
+        builds[i].file = symbol_index_file(object->full_filename) - files;
+        builds[i].version = version;
+        line_index_init(&builds[i].lines, object->buffer, object->buffer_length);
+        has_changed = true;
+    }
+
+    if(!has_changed) goto cleanup;
+
+    json_builder_t definition;
+
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, func->source)) continue;
+
+        // Definitions of functions are shared with every other use of their signatures
+        json_builder_init(&definition);
+        json_builder_append(&definition, signature_get(compiler, func)->definition);
+        symbol_index_add(&builds[func->source.object_index], func->source, SYMBOL_KIND_FUNCTION, func->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->func_aliases_length; i++){
+        ast_func_alias_t *falias = &ast->func_aliases[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, falias->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_func_alias_definition(&definition, falias);
+        symbol_index_add(&builds[falias->source.object_index], falias->source, SYMBOL_KIND_FUNCTION_ALIAS, falias->from, &definition);
+    }
+
+    for(length_t i = 0; i != ast->composites_length; i++){
+        ast_composite_t *composite = &ast->composites[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, composite->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_composite_definition(&definition, composite);
+        symbol_index_add(&builds[composite->source.object_index], composite->source, SYMBOL_KIND_COMPOSITE, composite->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->poly_composites_length; i++){
+        ast_composite_t *composite = (ast_composite_t*) &ast->poly_composites[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, composite->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_composite_definition(&definition, composite);
+        symbol_index_add(&builds[composite->source.object_index], composite->source, SYMBOL_KIND_COMPOSITE, composite->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->enums_length; i++){
+        ast_enum_t *enum_value = &ast->enums[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, enum_value->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_enum_definition(&definition, enum_value);
+        symbol_index_add(&builds[enum_value->source.object_index], enum_value->source, SYMBOL_KIND_ENUM, enum_value->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->aliases_length; i++){
+        ast_alias_t *alias = &ast->aliases[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, alias->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_alias_definition(&definition, alias);
+        symbol_index_add(&builds[alias->source.object_index], alias->source, SYMBOL_KIND_ALIAS, alias->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->named_expressions.length; i++){
+        ast_named_expression_t *named_expression = &ast->named_expressions.expressions[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, named_expression->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_named_expression_definition(&definition, named_expression);
+        symbol_index_add(&builds[named_expression->source.object_index], named_expression->source, SYMBOL_KIND_NAMED_EXPRESSION, named_expression->name, &definition);
+    }
+
+    for(length_t i = 0; i != ast->globals_length; i++){
+        ast_global_t *global = &ast->globals[i];
+        if(!symbol_index_is_building(builds, objects_length, objects, global->source)) continue;
+
+        json_builder_init(&definition);
+        json_build_global_definition(&definition, global);
+        symbol_index_add(&builds[global->source.object_index], global->source, SYMBOL_KIND_GLOBAL, global->name, &definition);
+    }
+
+    for(length_t i = 0; i != objects_length; i++){
+        symbol_index_build_t *build = &builds[i];
+        if(build->file == NAME_INDEX_NONE) continue;
+
+        // Files without any declarations still get a pool, so that they're known to be indexed
+        symbol_index_pool_add(&build->pool, NULL);
+
+        symbol_index_file_t *file = &files[build->file];
+        symbol_index_file_clear(file);
+
+        file->version = build->version;
+        file->is_owned = true;
+        file->records = build->records;
+        file->records_length = build->records_length;
+        file->strings = build->pool.chars;
+        file->strings_length = build->pool.length;
+    }
+
+    is_dirty = true;
+    symbol_index_save_when_due();
+
+cleanup:
+    for(length_t i = 0; i != objects_length; i++){
+        if(builds[i].file != NAME_INDEX_NONE) line_index_free(&builds[i].lines);
+    }
+
+    free(builds);
+}
+
+void symbol_index_replace(weak_cstr_t absolute, text_version_t version, symbol_declaration_list_t *declarations){
+    if(infrastructure == NULL) return;
+
+    // Declarations from compiling a file are more precise, so they're kept while they're current,
+    // and always while the file is open, since its unsaved contents are what was compiled
+    symbol_index_file_t *existing = symbol_index_find_file(absolute);
+    if(existing && text_version_is_current(&existing->version, version)) return;
+    if(existing && existing->version.is_known && !existing->is_shallow && overlay_exists(absolute)) return;
+
+    symbol_index_file_t *file = symbol_index_file(absolute);
+    symbol_index_file_clear(file);
+
+    symbol_index_pool_t pool = {0};
+    symbol_index_record_t *records = malloc(sizeof(symbol_index_record_t) * (declarations->length ? declarations->length : 1));
+    symbol_index_pool_add(&pool, NULL);
+
+    for(length_t i = 0; i != declarations->length; i++){
+        symbol_declaration_t *declaration = &declarations->declarations[i];
+
+        records[i] = (symbol_index_record_t){
+            .name = symbol_index_pool_add(&pool, declaration->name),
+            .definition = symbol_index_pool_add(&pool, declaration->definition),
+            .kind = declaration->kind,
+            .line = declaration->line,
+            .character = declaration->character,
+        };
+    }
+
+    file->version = version;
+    file->is_owned = true;
+    file->is_shallow = true;
+    file->records = records;
+    file->records_length = declarations->length;
+    file->strings = pool.chars;
+    file->strings_length = pool.length;
+
+    is_dirty = true;
+    symbol_index_save_when_due();
+}
+
+void symbol_declaration_list_free(symbol_declaration_list_t *list){
+    for(length_t i = 0; i != list->length; i++){
+        free(list->declarations[i].name);
+        free(list->declarations[i].definition);
+    }
+
+    free(list->declarations);
+}
+
+void symbol_index_forget(weak_cstr_t absolute){
+    symbol_index_file_t *file = symbol_index_find_file(absolute);
+    if(file == NULL || !file->version.is_known) return;
+
+    symbol_index_file_clear(file);
+    is_dirty = true;
+}
+
+static length_t symbol_index_writer_intern(symbol_index_writer_t *writer, weak_cstr_t string){
+    // NOTE: Strings are borrowed until the writer is done, so they must belong to files or be constant
+    if(string[0] == '\0') return symbol_index_pool_add(&writer->pool, NULL);
+
+    length_t found = name_index_find(&writer->strings_index, string);
+    if(found != NAME_INDEX_NONE) return writer->offsets[found];
+
+    expand((void**) &writer->offsets, sizeof(length_t), writer->offsets_length, &writer->offsets_capacity, 1, 1024);
+    writer->offsets[writer->offsets_length++] = symbol_index_pool_add(&writer->pool, string);
+    name_index_add(&writer->strings_index, string);
+    return writer->offsets[writer->offsets_length - 1];
+}
+
+static bool symbol_index_write(FILE *stream, const void *data, length_t size){
+    return size == 0 || fwrite(data, size, 1, stream) == 1;
+}
+
+successful_t symbol_index_save(void){
+    if(!is_dirty || cache_filename == NULL) return true;
+
+    successful_t successful = false;
+
+    symbol_index_writer_t writer = {0};
+    name_index_init(&writer.strings_index);
+
+    symbol_index_file_record_t *file_records = malloc(sizeof(symbol_index_file_record_t) * (files_length ? files_length : 1));
+    length_t file_records_length = 0;
+    symbol_index_record_t *records = NULL;
+    length_t records_length = 0;
+    length_t records_capacity = 0;
+
+    symbol_index_header_t header = {
+        .magic = SYMBOL_INDEX_MAGIC,
+        .format_version = SYMBOL_INDEX_FORMAT_VERSION,
+        .byte_order = SYMBOL_INDEX_BYTE_ORDER,
+        .infrastructure = symbol_index_writer_intern(&writer, infrastructure),
+        .compiler_version = symbol_index_writer_intern(&writer, ADEPT_VERSION_STRING),
+    };
+
+    for(length_t i = 0; i != files_length; i++){
+        symbol_index_file_t *file = &files[i];
+        if(!file->version.is_known) continue;
+
+        file_records[file_records_length++] = (symbol_index_file_record_t){
+            .filename = symbol_index_writer_intern(&writer, file->absolute),
+            .hash = file->version.hash,
+            .buffer_length = file->version.length,
+            .first_symbol = records_length,
+            .symbols_length = file->records_length,
+            .flags = file->is_shallow ? SYMBOL_INDEX_FILE_SHALLOW : 0,
+        };
+
+        expand((void**) &records, sizeof(symbol_index_record_t), records_length, &records_capacity, file->records_length, 1024);
+
+        for(length_t j = 0; j != file->records_length; j++){
+            symbol_index_record_t record = file->records[j];
+            record.name = symbol_index_writer_intern(&writer, symbol_index_string(file->strings, file->strings_length, record.name));
+            record.definition = symbol_index_writer_intern(&writer, symbol_index_string(file->strings, file->strings_length, record.definition));
+            records[records_length++] = record;
+        }
+    }
+
+    // Pad the string pool so that the file is a multiple of 8 bytes long
+    while(writer.pool.length % 8 != 0){
+        expand((void**) &writer.pool.chars, sizeof(char), writer.pool.length, &writer.pool.capacity, 1, 4096);
+        writer.pool.chars[writer.pool.length++] = '\0';
+    }
+
+    header.files_length = file_records_length;
+    header.symbols_length = records_length;
+    header.strings_length = writer.pool.length;
+
+    // Written to a temporary file first, so that readers never see a partially written index,
+    // and so that existing mappings of the previous cache file stay intact
+    #ifdef SYMBOL_INDEX_MAP_SUPPORTED
+    strong_cstr_t temporary_filename = mallocandsprintf("%s.%d.tmp", cache_filename, (int) getpid());
+    #else
+    strong_cstr_t temporary_filename = mallocandsprintf("%s.tmp", cache_filename);
+    #endif
+
+    FILE *stream = fopen(temporary_filename, "wb");
+
+    if(stream){
+        bool written = symbol_index_write(stream, &header, sizeof header)
+                    && symbol_index_write(stream, file_records, sizeof(symbol_index_file_record_t) * file_records_length)
+                    && symbol_index_write(stream, records, sizeof(symbol_index_record_t) * records_length)
+                    && symbol_index_write(stream, writer.pool.chars, writer.pool.length);
+
+        written = fclose(stream) == 0 && written;
+
+        #ifndef SYMBOL_INDEX_MAP_SUPPORTED
+        if(written) remove(cache_filename);
+        #endif
+
+        if(written && rename(temporary_filename, cache_filename) == 0){
+            successful = true;
+        } else {
+            remove(temporary_filename);
+        }
+    }
+
+    free(temporary_filename);
+    free(records);
+    free(file_records);
+    free(writer.offsets);
+    free(writer.pool.chars);
+    name_index_free(&writer.strings_index);
+
+    // Failing to write is only retried after the usual interval
+    is_dirty = !successful;
+    last_saved = time(NULL);
+
+    return successful;
+}
+
+symbol_list_t symbol_index_find(weak_cstr_t name, bool is_prefix){
+    symbol_list_t list = {0};
+    length_t name_length = strlen(name);
+
+    for(length_t i = 0; i != files_length; i++){
+        symbol_index_file_t *file = &files[i];
+
+        for(length_t j = 0; j != file->records_length; j++){
+            const symbol_index_record_t *record = &file->records[j];
+            weak_cstr_t symbol_name = symbol_index_string(file->strings, file->strings_length, record->name);
+
+            if(is_prefix ? strncmp(symbol_name, name, name_length) != 0 : !streq(symbol_name, name)) continue;
+
+            list_append(&list, ((symbol_t){
+                .name = symbol_name,
+                .definition = symbol_index_string(file->strings, file->strings_length, record->definition),
+                .filename = file->absolute,
+                .kind = record->kind < SYMBOL_KIND_COUNT ? record->kind : SYMBOL_KIND_FUNCTION,
+                .line = record->line,
+                .character = record->character,
+            }), symbol_t);
+        }
+    }
+
+    return list;
+}
+
+static int symbol_index_ranked_compare(const void *a, const void *b){
+    const symbol_index_ranked_t *ranked_a = a;
+    const symbol_index_ranked_t *ranked_b = b;
+
+    if(ranked_a->rank != ranked_b->rank) return ranked_a->rank < ranked_b->rank ? -1 : 1;
+    if(ranked_a->file != ranked_b->file) return ranked_a->file < ranked_b->file ? -1 : 1;
+    return ranked_a->record < ranked_b->record ? -1 : ranked_a->record > ranked_b->record;
+}
+
+static void symbol_index_prepare_search(void){
+    // Only files that changed since the last search have their names interned again
+    if(!is_searchable){
+        name_search_init(&names);
+        is_searchable = true;
+    }
+
+    for(length_t i = 0; i != files_length; i++){
+        symbol_index_file_t *file = &files[i];
+        if(!file->version.is_known || file->names) continue;
+
+        file->names = malloc(sizeof(length_t) * (file->records_length ? file->records_length : 1));
+
+        for(length_t j = 0; j != file->records_length; j++){
+            file->names[j] = name_search_use(&names, symbol_index_string(file->strings, file->strings_length, file->records[j].name));
+        }
+    }
+
+    if(name_ranks_capacity < names.length){
+        name_ranks = realloc(name_ranks, sizeof(length_t) * names.length);
+
+        for(length_t i = name_ranks_capacity; i != names.length; i++){
+            name_ranks[i] = NAME_INDEX_NONE;
+        }
+
+        name_ranks_capacity = names.length;
+    }
+}
+
+symbol_list_t symbol_index_search(weak_cstr_t text, length_t limit){
+    symbol_list_t list = {0};
+    if(limit == 0) return list;
+
+    symbol_index_prepare_search();
+
+    name_search_match_list_t matches = name_search_find(&names, text, limit);
+
+    for(length_t i = 0; i != matches.length; i++){
+        name_ranks[matches.matches[i].name] = i;
+    }
+
+    // Declarations of the best names are found with a single pass over the names of each file
+    symbol_index_ranked_t *ranked = NULL;
+    length_t ranked_length = 0;
+    length_t ranked_capacity = 0;
+
+    for(length_t i = 0; i != files_length; i++){
+        symbol_index_file_t *file = &files[i];
+        if(file->names == NULL) continue;
+
+        for(length_t j = 0; j != file->records_length; j++){
+            length_t rank = name_ranks[file->names[j]];
+            if(rank == NAME_INDEX_NONE) continue;
+
+            expand((void**) &ranked, sizeof(symbol_index_ranked_t), ranked_length, &ranked_capacity, 1, 64);
+            ranked[ranked_length++] = (symbol_index_ranked_t){
+                .rank = rank,
+                .file = i,
+                .record = j,
+            };
+        }
+    }
+
+    for(length_t i = 0; i != matches.length; i++){
+        name_ranks[matches.matches[i].name] = NAME_INDEX_NONE;
+    }
+
+    qsort(ranked, ranked_length, sizeof(symbol_index_ranked_t), symbol_index_ranked_compare);
+
+    for(length_t i = 0; i != ranked_length && i != limit; i++){
+        symbol_index_file_t *file = &files[ranked[i].file];
+        const symbol_index_record_t *record = &file->records[ranked[i].record];
+
+        list_append(&list, ((symbol_t){
+            .name = symbol_index_string(file->strings, file->strings_length, record->name),
+            .definition = symbol_index_string(file->strings, file->strings_length, record->definition),
+            .filename = file->absolute,
+            .kind = record->kind < SYMBOL_KIND_COUNT ? record->kind : SYMBOL_KIND_FUNCTION,
+            .line = record->line,
+            .character = record->character,
+        }), symbol_t);
+    }
+
+    free(ranked);
+    free(matches.matches);
+    return list;
+}
+
+weak_cstr_t symbol_kind_name(symbol_kind_t kind){
+    switch(kind){
+    case SYMBOL_KIND_FUNCTION:         return "function";
+    case SYMBOL_KIND_FUNCTION_ALIAS:   return "function-alias";
+    case SYMBOL_KIND_COMPOSITE:        return "composite";
+    case SYMBOL_KIND_ENUM:             return "enum";
+    case SYMBOL_KIND_ALIAS:            return "alias";
+    case SYMBOL_KIND_NAMED_EXPRESSION: return "named-expression";
+    case SYMBOL_KIND_GLOBAL:           return "global";
+    default:                           return "unknown";
+    }
+}
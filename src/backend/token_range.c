@@ -0,0 +1,81 @@
+
+#include <string.h>
+
+#include "token_range.h"
+
+length_t token_range_offset(const char *buffer, length_t buffer_length, length_t line, length_t character, length_t *out_line_begin){
+    return token_range_offset_from(buffer, buffer_length, 0, 0, line, character, out_line_begin);
+}
+
+length_t token_range_offset_from(const char *buffer, length_t buffer_length, length_t from_line, length_t from_line_begin,
+        length_t line, length_t character, length_t *out_line_begin){
+
+    // Lines before the known line have to be counted from the beginning
+    if(line < from_line){
+        from_line = 0;
+        from_line_begin = 0;
+    }
+
+    length_t line_begin = from_line_begin;
+
+    // Skip to the beginning of the line
+    for(length_t i = from_line; i != line; i++){
+        const char *newline = memchr(&buffer[line_begin], '\n', buffer_length - line_begin);
+
+        if(newline == NULL){
+            if(out_line_begin) *out_line_begin = line_begin;
+            return buffer_length;
+        }
+
+        line_begin = newline - buffer + 1;
+    }
+
+    if(out_line_begin) *out_line_begin = line_begin;
+
+    // Don't go past the end of the line
+    const char *newline = memchr(&buffer[line_begin], '\n', buffer_length - line_begin);
+    length_t line_end = newline ? (length_t) (newline - buffer) : buffer_length;
+
+    return character < line_end - line_begin ? line_begin + character : line_end;
+}
+
+length_t token_range_first_at(tokenlist_t *tokenlist, length_t offset){
+    // Tokens are in order of where they begin
+    length_t low = 0;
+    length_t high = tokenlist->length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(tokenlist->sources[middle].index < offset){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+token_range_t token_range_between(tokenlist_t *tokenlist, const char *buffer, length_t buffer_length,
+        length_t start_line, length_t start_character, length_t end_line, length_t end_character, length_t *out_start_line_begin){
+
+    length_t start_line_begin;
+    length_t start = token_range_offset(buffer, buffer_length, start_line, start_character, &start_line_begin);
+    length_t end = token_range_offset_from(buffer, buffer_length, start_line, start_line_begin, end_line, end_character, NULL);
+    if(out_start_line_begin) *out_start_line_begin = start_line_begin;
+
+    token_range_t range;
+    range.begin = token_range_first_at(tokenlist, start);
+    range.end = end > start ? token_range_first_at(tokenlist, end) : range.begin;
+    return range;
+}
+
+successful_t token_range_word(tokenlist_t *tokenlist, const char *buffer, length_t index, char *out_word, length_t capacity){
+    source_t source = tokenlist->sources[index];
+    if(source.stride >= capacity) return false;
+
+    memcpy(out_word, &buffer[source.index], source.stride);
+    out_word[source.stride] = '\0';
+    return true;
+}
@@ -0,0 +1,604 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !__EMSCRIPTEN__
+#define WORKSPACE_INDEX_THREADS
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#endif
+
+#include "workspace_index.h"
+#include "json_builder.h"
+#include "symbol_index.h"
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "DRVR/overlay.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/filename.h"
+#include "UTIL/hash.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+#include "UTIL/__insight_undo_overloads.h"
+
+// Most workers to index with, which is further limited by the number of processors
+#define WORKSPACE_INDEX_MAX_WORKERS 4
+
+// Milliseconds that each worker rests after each file
+#define WORKSPACE_INDEX_REST 2
+
+// Most files to index, so that huge folders don't take over the server
+#define WORKSPACE_INDEX_MAX_FILES 20000
+
+// Files to index each time declarations are collected, when there aren't any threads
+#define WORKSPACE_INDEX_BATCH 8
+
+// ---------------- workspace_index_job_t ----------------
+// A folder to look for files within, or a file to index
+typedef struct {
+    strong_cstr_t path;
+    bool is_folder;
+} workspace_index_job_t;
+
+// ---------------- workspace_index_result_t ----------------
+// The declarations of an indexed file
+typedef struct {
+    strong_cstr_t absolute;
+    text_version_t version;
+    symbol_declaration_list_t declarations;
+} workspace_index_result_t;
+
+// ---------------- workspace_index_scan_t ----------------
+// Position within a file while looking for declarations
+typedef struct {
+    const char *buffer;
+    length_t buffer_length;
+    tokenlist_t *tokenlist;
+    length_t offset;
+    length_t line;
+    length_t line_begin;
+} workspace_index_scan_t;
+
+// NOTE: Everything below is shared with workers, and is guarded by 'lock'
+static strong_cstr_list_t folders;
+static workspace_index_job_t *jobs = NULL;
+static length_t jobs_length = 0;
+static length_t jobs_capacity = 0;
+static workspace_index_result_t *results = NULL;
+static length_t results_length = 0;
+static length_t results_capacity = 0;
+static length_t files_found = 0;
+static length_t working = 0;
+static length_t pauses = 0;
+
+#ifdef WORKSPACE_INDEX_THREADS
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static bool has_workers = false;
+#endif
+
+static void workspace_index_lock(void){
+    #ifdef WORKSPACE_INDEX_THREADS
+    pthread_mutex_lock(&lock);
+    #endif
+}
+
+static void workspace_index_unlock(void){
+    #ifdef WORKSPACE_INDEX_THREADS
+    pthread_mutex_unlock(&lock);
+    #endif
+}
+
+static void workspace_index_wake(void){
+    #ifdef WORKSPACE_INDEX_THREADS
+    pthread_cond_broadcast(&wake);
+    #endif
+}
+
+static void workspace_index_push(strong_cstr_t path, bool is_folder){
+    // NOTE: The lock must be held
+    // NOTE: Takes ownership of 'path'
+    if(!is_folder){
+        if(files_found == WORKSPACE_INDEX_MAX_FILES){
+            free(path);
+            return;
+        }
+
+        files_found++;
+    }
+
+    expand((void**) &jobs, sizeof(workspace_index_job_t), jobs_length, &jobs_capacity, 1, 64);
+
+    jobs[jobs_length++] = (workspace_index_job_t){
+        .path = path,
+        .is_folder = is_folder,
+    };
+}
+
+static bool workspace_index_is_adept_file(weak_cstr_t filename){
+    length_t length = strlen(filename);
+    return length > 6 && streq(&filename[length - 6], ".adept");
+}
+
+static bool workspace_index_is_folder(weak_cstr_t path){
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+static void workspace_index_enumerate(weak_cstr_t folder){
+    // Hidden entries, such as '.git', and symbolic links are skipped,
+    // which also keeps links from leading to the same folders forever
+    #ifdef WORKSPACE_INDEX_THREADS
+    DIR *directory = opendir(folder);
+    if(directory == NULL) return;
+
+    struct dirent *entry;
+
+    while((entry = readdir(directory))){
+        if(entry->d_name[0] == '.') continue;
+
+        strong_cstr_t path = mallocandsprintf("%s/%s", folder, entry->d_name);
+        struct stat info;
+
+        if(lstat(path, &info) != 0 || S_ISLNK(info.st_mode)){
+            free(path);
+            continue;
+        }
+
+        bool is_folder = S_ISDIR(info.st_mode);
+
+        if(is_folder || (S_ISREG(info.st_mode) && workspace_index_is_adept_file(entry->d_name))){
+            workspace_index_lock();
+            workspace_index_push(path, is_folder);
+            workspace_index_unlock();
+        } else {
+            free(path);
+        }
+    }
+
+    closedir(directory);
+    #elif defined(_WIN32) || defined(_WIN64)
+    strong_cstr_t pattern = mallocandsprintf("%s\\*", folder);
+    WIN32_FIND_DATAA entry;
+    HANDLE handle = FindFirstFileA(pattern, &entry);
+    free(pattern);
+
+    if(handle == INVALID_HANDLE_VALUE) return;
+
+    do {
+        if(entry.cFileName[0] == '.' || entry.dwFileAttributes & (FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_REPARSE_POINT)) continue;
+
+        bool is_folder = entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
+
+        if(is_folder || workspace_index_is_adept_file(entry.cFileName)){
+            workspace_index_push(mallocandsprintf("%s\\%s", folder, entry.cFileName), is_folder);
+        }
+    } while(FindNextFileA(handle, &entry));
+
+    FindClose(handle);
+    #else
+    (void) folder;
+    #endif
+}
+
+static void workspace_index_advance(workspace_index_scan_t *scan, length_t offset, length_t *out_line, length_t *out_character){
+    // Tokens are visited in order, so lines only have to be counted once
+    while(scan->offset < offset && scan->offset < scan->buffer_length){
+        if(scan->buffer[scan->offset++] == '\n'){
+            scan->line++;
+            scan->line_begin = scan->offset;
+        }
+    }
+
+    *out_line = scan->line;
+    *out_character = offset - scan->line_begin;
+}
+
+static length_t workspace_index_head_end(tokenlist_t *tokenlist, length_t i, bool stop_at_assign){
+    // Finds the token that ends the head of a declaration,
+    // which is the first '{' or newline outside of any parentheses or brackets
+    length_t nesting = 0;
+
+    for(; i < tokenlist->length; i++){
+        tokenid_t id = tokenlist->tokens[i].id;
+
+        if(id == TOKEN_OPEN || id == TOKEN_BRACKET_OPEN){
+            nesting++;
+        } else if((id == TOKEN_CLOSE || id == TOKEN_BRACKET_CLOSE) && nesting != 0){
+            nesting--;
+        } else if(nesting == 0 && (id == TOKEN_BEGIN || id == TOKEN_NEWLINE || (stop_at_assign && id == TOKEN_ASSIGN))){
+            break;
+        }
+    }
+
+    return i;
+}
+
+static strong_cstr_t workspace_index_definition(workspace_index_scan_t *scan, length_t first, length_t end){
+    // Definitions are the text of the head of the declaration, with all whitespace made into single spaces
+    tokenlist_t *tokenlist = scan->tokenlist;
+    length_t begin = tokenlist->sources[first].index;
+    length_t stop = end < tokenlist->length ? tokenlist->sources[end].index : scan->buffer_length;
+    if(stop > scan->buffer_length) stop = scan->buffer_length;
+
+    char *text = malloc(stop > begin ? stop - begin + 1 : 1);
+    length_t length = 0;
+
+    for(length_t i = begin; i < stop; i++){
+        char c = scan->buffer[i];
+
+        if(c == ' ' || c == '\t' || c == '\n' || c == '\r'){
+            if(length != 0 && text[length - 1] != ' ') text[length++] = ' ';
+        } else {
+            text[length++] = c;
+        }
+    }
+
+    while(length != 0 && text[length - 1] == ' ') length--;
+    text[length] = '\0';
+
+    json_builder_t builder;
+    json_builder_init(&builder);
+    json_build_string(&builder, text);
+    free(text);
+
+    return json_builder_finalize(&builder);
+}
+
+static void workspace_index_declare(workspace_index_scan_t *scan, symbol_declaration_list_t *declarations, symbol_kind_t kind, length_t keyword, length_t name, length_t first, length_t end){
+    length_t line, character;
+    workspace_index_advance(scan, scan->tokenlist->sources[keyword].index, &line, &character);
+
+    list_append(declarations, ((symbol_declaration_t){
+        .name = strclone((char*) scan->tokenlist->tokens[name].data),
+        .definition = workspace_index_definition(scan, first, end),
+        .kind = kind,
+        .line = line,
+        .character = character,
+    }), symbol_declaration_t);
+}
+
+static length_t workspace_index_skip_generics(tokenlist_t *tokenlist, length_t i){
+    // Skips the generics of a polymorphic composite or alias, such as '<$T>'
+    if(i >= tokenlist->length || tokenlist->tokens[i].id != TOKEN_LESSTHAN) return i;
+
+    while(i < tokenlist->length && tokenlist->tokens[i].id != TOKEN_GREATERTHAN && tokenlist->tokens[i].id != TOKEN_NEWLINE) i++;
+    return i + 1;
+}
+
+static symbol_declaration_list_t workspace_index_scan(const char *buffer, length_t buffer_length, tokenlist_t *tokenlist){
+    // Finds declarations from tokens alone, without parsing
+    symbol_declaration_list_t declarations = {0};
+    workspace_index_scan_t scan = {
+        .buffer = buffer,
+        .buffer_length = buffer_length,
+        .tokenlist = tokenlist,
+    };
+
+    token_t *tokens = tokenlist->tokens;
+    length_t depth = 0;
+    length_t nesting = 0;
+    bool is_statement_start = true;
+
+    for(length_t i = 0; i != tokenlist->length; i++){
+        tokenid_t id = tokens[i].id;
+        bool has_next_word = i + 1 < tokenlist->length && tokens[i + 1].id == TOKEN_WORD;
+        bool is_top_level = depth == 0 && nesting == 0;
+        bool was_statement_start = is_statement_start;
+        is_statement_start = false;
+
+        switch(id){
+        case TOKEN_BEGIN:
+            depth++;
+            is_statement_start = true;
+            break;
+        case TOKEN_END:
+            if(depth != 0) depth--;
+            is_statement_start = true;
+            break;
+        case TOKEN_OPEN:
+        case TOKEN_BRACKET_OPEN:
+            nesting++;
+            break;
+        case TOKEN_CLOSE:
+        case TOKEN_BRACKET_CLOSE:
+            if(nesting != 0) nesting--;
+            break;
+        case TOKEN_NEWLINE:
+            is_statement_start = nesting == 0;
+            break;
+        case TOKEN_PACKED:
+        case TOKEN_EXTERNAL:
+        case TOKEN_THREAD_LOCAL:
+        case TOKEN_EXHAUSTIVE:
+            // Modifiers keep the declaration that follows at the start of its statement
+            is_statement_start = was_statement_start;
+            break;
+        case TOKEN_FUNC:
+            // Functions are declared at the top level and within composites,
+            // and 'func' followed by anything else is a function pointer or lambda
+            if(i + 2 < tokenlist->length && tokens[i + 1].id == TOKEN_ALIAS && tokens[i + 2].id == TOKEN_WORD){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_FUNCTION_ALIAS, i, i + 2, i, workspace_index_head_end(tokenlist, i, false));
+            } else if(has_next_word){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_FUNCTION, i, i + 1, i + 1, workspace_index_head_end(tokenlist, i, true));
+            }
+            break;
+        case TOKEN_FOREIGN:
+            if(is_top_level && has_next_word){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_FUNCTION, i, i + 1, i + 1, workspace_index_head_end(tokenlist, i, false));
+            }
+            break;
+        case TOKEN_STRUCT:
+        case TOKEN_UNION:
+        case TOKEN_CLASS:
+        case TOKEN_RECORD: {
+                length_t name = workspace_index_skip_generics(tokenlist, i + 1);
+
+                if(is_top_level && was_statement_start && name < tokenlist->length && tokens[name].id == TOKEN_WORD){
+                    // Fields can span many lines, so only the name is kept
+                    workspace_index_declare(&scan, &declarations, SYMBOL_KIND_COMPOSITE, i, name, i, name + 1);
+                }
+            }
+            break;
+        case TOKEN_ENUM:
+            if(is_top_level && was_statement_start && has_next_word){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_ENUM, i, i + 1, i, workspace_index_head_end(tokenlist, i, false));
+            }
+            break;
+        case TOKEN_ALIAS: {
+                length_t name = workspace_index_skip_generics(tokenlist, i + 1);
+
+                if(is_top_level && was_statement_start && name < tokenlist->length && tokens[name].id == TOKEN_WORD){
+                    workspace_index_declare(&scan, &declarations, SYMBOL_KIND_ALIAS, i, name, i, workspace_index_head_end(tokenlist, i, false));
+                }
+            }
+            break;
+        case TOKEN_DEFINE:
+            if(is_top_level && was_statement_start && has_next_word){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_NAMED_EXPRESSION, i, i + 1, i, workspace_index_head_end(tokenlist, i, false));
+            }
+            break;
+        case TOKEN_WORD:
+            // Statements at the top level that begin with a name are global variables
+            if(is_top_level && was_statement_start && i + 1 < tokenlist->length && tokens[i + 1].id != TOKEN_NEWLINE && tokens[i + 1].id != TOKEN_ASSIGN){
+                workspace_index_declare(&scan, &declarations, SYMBOL_KIND_GLOBAL, i, i, i, workspace_index_head_end(tokenlist, i, true));
+            }
+            break;
+        }
+    }
+
+    return declarations;
+}
+
+static void workspace_index_file(strong_cstr_t filename){
+    // NOTE: Takes ownership of 'filename'
+    strong_cstr_t buffer;
+    length_t buffer_length;
+
+    if(!file_text_contents(filename, &buffer, &buffer_length, true)){
+        free(filename);
+        return;
+    }
+
+    // Only lexing is needed to find declarations, and the compiler is only
+    // there for errors, so it doesn't need to be initialized
+    // NOTE: The object doesn't have a full filename, which keeps the lexer
+    //       from updating the reference index, which belongs to the other thread
+    object_t object = {
+        .filename = filename,
+        .buffer = buffer,
+        .buffer_length = buffer_length,
+        .index = 0,
+    };
+
+    object_t *objects[1] = {&object};
+
+    compiler_t compiler = {
+        .objects = objects,
+        .objects_length = 1,
+        .objects_capacity = 1,
+    };
+
+    workspace_index_result_t result = {
+        .absolute = filename,
+    };
+
+    if(lex_buffer(&compiler, &object) == SUCCESS){
+        result.declarations = workspace_index_scan(buffer, buffer_length, &object.tokenlist);
+        tokenlist_free(&object.tokenlist);
+    }
+
+    // NOTE: The buffer is hashed by the lexer even when lexing fails
+    result.version = text_version(object.buffer_hash, buffer_length);
+
+    if(compiler.error) adept_error_free_fully(compiler.error);
+    free(buffer);
+
+    workspace_index_lock();
+    expand((void**) &results, sizeof(workspace_index_result_t), results_length, &results_capacity, 1, 64);
+    results[results_length++] = result;
+    workspace_index_unlock();
+}
+
+static void workspace_index_do(workspace_index_job_t job){
+    if(job.is_folder){
+        workspace_index_enumerate(job.path);
+        free(job.path);
+    } else {
+        workspace_index_file(job.path);
+    }
+}
+
+#ifdef WORKSPACE_INDEX_THREADS
+static void *workspace_index_work(void *data){
+    (void) data;
+
+    pthread_mutex_lock(&lock);
+
+    for(;;){
+        while(jobs_length == 0 || pauses != 0){
+            pthread_cond_wait(&wake, &lock);
+        }
+
+        workspace_index_job_t job = jobs[--jobs_length];
+        working++;
+        pthread_mutex_unlock(&lock);
+
+        workspace_index_do(job);
+
+        // Rest a little after each job, so that indexing never takes over the machine
+        struct timespec rest = {0, WORKSPACE_INDEX_REST * 1000000L};
+        nanosleep(&rest, NULL);
+
+        pthread_mutex_lock(&lock);
+        working--;
+
+        // Folders add jobs for the other workers
+        if(job.is_folder) pthread_cond_broadcast(&wake);
+    }
+
+    return NULL;
+}
+
+static void workspace_index_start_workers(void){
+    // NOTE: The lock must not be held
+    if(has_workers) return;
+    has_workers = true;
+
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    long count = processors > 2 ? processors / 2 : 1;
+    if(count > WORKSPACE_INDEX_MAX_WORKERS) count = WORKSPACE_INDEX_MAX_WORKERS;
+
+    // Workers live for as long as the server does, and wait for jobs whenever there aren't any
+    for(long i = 0; i != count; i++){
+        pthread_t thread;
+
+        if(pthread_create(&thread, NULL, workspace_index_work, NULL) == 0){
+            pthread_detach(thread);
+        }
+    }
+}
+#endif
+
+static bool workspace_index_is_within(weak_cstr_t folder, weak_cstr_t absolute){
+    length_t length = strlen(folder);
+    return strncmp(folder, absolute, length) == 0 && (absolute[length] == '/' || absolute[length] == '\\');
+}
+
+void workspace_index_start(strong_cstr_list_t *new_folders){
+    bool has_new_folders = false;
+
+    workspace_index_lock();
+
+    for(length_t i = 0; i != new_folders->length; i++){
+        weak_cstr_t folder = new_folders->items[i];
+        if(!workspace_index_is_folder(folder)) continue;
+
+        strong_cstr_t absolute = filename_absolute(folder);
+        if(absolute == NULL) continue;
+
+        bool is_known = false;
+
+        for(length_t j = 0; j != folders.length; j++){
+            if(streq(folders.items[j], absolute) || workspace_index_is_within(folders.items[j], absolute)){
+                is_known = true;
+                break;
+            }
+        }
+
+        if(is_known){
+            free(absolute);
+            continue;
+        }
+
+        strong_cstr_list_append(&folders, strclone(absolute));
+        workspace_index_push(absolute, true);
+        has_new_folders = true;
+    }
+
+    workspace_index_unlock();
+
+    if(has_new_folders){
+        #ifdef WORKSPACE_INDEX_THREADS
+        workspace_index_start_workers();
+        #endif
+
+        workspace_index_wake();
+    }
+}
+
+void workspace_index_refresh(weak_cstr_t absolute){
+    if(!workspace_index_is_adept_file(absolute) || !file_exists(absolute)) return;
+
+    // Open files are indexed from their unsaved contents whenever they're compiled instead
+    if(overlay_exists(absolute)) return;
+
+    workspace_index_lock();
+
+    for(length_t i = 0; i != folders.length; i++){
+        if(workspace_index_is_within(folders.items[i], absolute)){
+            workspace_index_push(strclone(absolute), false);
+            workspace_index_wake();
+            break;
+        }
+    }
+
+    workspace_index_unlock();
+}
+
+bool workspace_index_collect(void){
+    #ifndef WORKSPACE_INDEX_THREADS
+    // Without workers, a few files are indexed each time instead
+    for(length_t i = 0; i != WORKSPACE_INDEX_BATCH && jobs_length != 0; i++){
+        workspace_index_do(jobs[--jobs_length]);
+    }
+    #endif
+
+    workspace_index_lock();
+
+    workspace_index_result_t *collected = results;
+    length_t collected_length = results_length;
+    bool is_busy = jobs_length != 0 || working != 0;
+
+    results = NULL;
+    results_length = 0;
+    results_capacity = 0;
+
+    workspace_index_unlock();
+
+    for(length_t i = 0; i != collected_length; i++){
+        workspace_index_result_t *result = &collected[i];
+
+        symbol_index_replace(result->absolute, result->version, &result->declarations);
+        symbol_declaration_list_free(&result->declarations);
+        free(result->absolute);
+    }
+
+    free(collected);
+
+    // Everything found is written to the cache file once indexing is done
+    if(!is_busy && collected_length != 0) symbol_index_save();
+
+    return is_busy;
+}
+
+void workspace_index_pause(void){
+    workspace_index_lock();
+    pauses++;
+    workspace_index_unlock();
+}
+
+void workspace_index_resume(void){
+    workspace_index_lock();
+    if(pauses != 0 && --pauses == 0) workspace_index_wake();
+    workspace_index_unlock();
+}